@@ -28,7 +28,7 @@ android {
 
 
         ndk {
-            abiFilters += listOf("arm64-v8a")  // Target modern Arm chips only
+            abiFilters += listOf("arm64-v8a", "x86_64")  // Modern Arm chips, plus x86_64 emulators
         }
     }
 
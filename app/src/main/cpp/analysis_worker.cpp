@@ -0,0 +1,88 @@
+// app/src/main/cpp/analysis_worker.cpp
+#include "analysis_worker.h"
+#include "ring_buffer.h"
+#include "signal_processor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+using Clock = std::chrono::steady_clock;
+
+static int clampInterval(int intervalMs) {
+    return std::max(50, intervalMs);
+}
+
+AnalysisWorker::AnalysisWorker(SignalProcessor& processor, int intervalMs)
+        : mProcessor(processor), mIntervalMs(clampInterval(intervalMs)) {
+    size_t bytes = SampleRing::kHeaderBytes + kQueueCapacity * SampleRing::kRecordBytes;
+    void* memory = nullptr;
+    if (posix_memalign(&memory, kCacheLineSize, bytes) != 0) throw std::bad_alloc();
+    mQueueMemory = static_cast<uint8_t*>(memory);
+    std::fill(mQueueMemory, mQueueMemory + bytes, 0);
+    mQueue.attach(mQueueMemory, bytes);
+
+    mThread = std::thread(&AnalysisWorker::run, this);
+}
+
+AnalysisWorker::~AnalysisWorker() {
+    {
+        std::lock_guard<std::mutex> wake(mWakeLock);
+        mStop = true;
+    }
+    mWake.notify_one();
+    mThread.join();
+    free(mQueueMemory);
+}
+
+void AnalysisWorker::setInterval(int intervalMs) {
+    // Takes effect once the analysis already scheduled has run
+    mIntervalMs.store(clampInterval(intervalMs), std::memory_order_relaxed);
+}
+
+void AnalysisWorker::onReset() {
+    mQueue.discard();
+    uint32_t sequence = mCurrent.sequence;
+    mCurrent = AnalysisResult{};
+    mCurrent.sequence = sequence;
+    publish();
+}
+
+void AnalysisWorker::publish() {
+    mProcessor.publishWaveform();
+    mCurrent.sampleCount = mProcessor.getSampleCount();
+    mCurrent.effectiveFps = mProcessor.getEffectiveFps();
+    mCurrent.jitterMs = mProcessor.getJitterMs();
+    mResult.store(mCurrent);
+}
+
+void AnalysisWorker::run() {
+    Clock::time_point nextAnalysis = Clock::now();
+    std::unique_lock<std::mutex> wake(mWakeLock);
+    while (!mStop) {
+        wake.unlock();
+        {
+            std::lock_guard<std::mutex> guard(mLock);
+            mQueue.drain([this](float value, int64_t timestamp) {
+                mProcessor.addSample(value, timestamp);
+            });
+            mProcessor.drainInput();
+
+            Clock::time_point now = Clock::now();
+            if (now >= nextAnalysis) {
+                mCurrent.heartRate = mProcessor.computeHeartRate();
+                mCurrent.respirationRate = mProcessor.computeRespirationRate();
+                mCurrent.peakToNoise = mProcessor.getPeakToNoise();
+                ++mCurrent.sequence;
+                nextAnalysis = now + std::chrono::milliseconds(mIntervalMs.load(std::memory_order_relaxed));
+            }
+            publish();
+        }
+        wake.lock();
+
+        // Sleep until the next drain or analysis, whichever is sooner
+        Clock::time_point wakeAt = std::min(nextAnalysis,
+                                            Clock::now() + std::chrono::milliseconds(kDrainPeriodMs));
+        mWake.wait_until(wake, wakeAt, [this] { return mStop; });
+    }
+}
@@ -0,0 +1,106 @@
+// app/src/main/cpp/analysis_worker.h
+#ifndef OJAS_ANALYSIS_WORKER_H
+#define OJAS_ANALYSIS_WORKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include "sample_ring.h"
+#include "seqlock.h"
+
+class SignalProcessor;
+
+// Latest published state of a worker's processor
+struct AnalysisResult {
+    float heartRate;
+    float respirationRate;  // 0 while the processor's respiration is off
+    float peakToNoise;      // see SignalProcessor::getPeakToNoise()
+    float effectiveFps;
+    float jitterMs;
+    int32_t sampleCount;
+    uint32_t sequence;      // analyses completed since the worker started
+};
+
+// Floats per AnalysisResult as packed for Kotlin, in field order
+constexpr int kPackedAnalysisResult = 7;
+
+/**
+ * Background thread that owns a SignalProcessor's analysis.
+ *
+ * Samples reach it without locks, either through the processor's shared
+ * SampleRing or through offer() into a queue of the worker's own. The thread
+ * drains both every kDrainPeriodMs, runs the heart-rate and respiration
+ * estimators once per interval and publishes an AnalysisResult through a
+ * SeqLock, so latest() never blocks. The processor's waveform snapshot is
+ * republished after every drain.
+ *
+ * Anything else that touches the processor (reset, setters, reading the
+ * window) must hold pause() so it cannot overlap a drain or an analysis.
+ */
+class AnalysisWorker {
+public:
+    static constexpr int kDrainPeriodMs = 250;
+    static constexpr int kQueueCapacity = 256;
+
+    AnalysisWorker(SignalProcessor& processor, int intervalMs);
+    ~AnalysisWorker();
+
+    AnalysisWorker(const AnalysisWorker&) = delete;
+    AnalysisWorker& operator=(const AnalysisWorker&) = delete;
+
+    // Producer side of the worker queue; one thread only. False if full.
+    bool offer(float value, int64_t timestamp) { return mQueue.offer(value, timestamp); }
+
+    AnalysisResult latest() const { return mResult.load(); }
+
+    void setInterval(int intervalMs);
+
+    std::unique_lock<std::mutex> pause() { return std::unique_lock<std::mutex>(mLock); }
+
+    // Called by SignalProcessor::reset() under pause(): drops queued samples
+    // and publishes an empty result
+    void onReset();
+
+private:
+    SignalProcessor& mProcessor;
+    std::atomic<int> mIntervalMs;
+
+    uint8_t* mQueueMemory = nullptr;
+    SampleRing mQueue;
+
+    // Guarded by mLock
+    AnalysisResult mCurrent{};
+    SeqLock<AnalysisResult> mResult;
+
+    std::mutex mLock;
+    std::mutex mWakeLock;
+    std::condition_variable mWake;
+    bool mStop = false;
+    std::thread mThread;    // last, so it starts after everything above exists
+
+    void run();
+    void publish();
+};
+
+/**
+ * A processor's worker, kept alive (and, from pauseWorker(), paused) for as
+ * long as the reference is held. Null when no worker runs; start/stop wait
+ * for every reference to go, so a null one also keeps a worker from starting
+ * underneath a caller that uses the processor directly.
+ */
+class WorkerRef {
+public:
+    AnalysisWorker* operator->() const { return mWorker; }
+    explicit operator bool() const { return mWorker != nullptr; }
+
+private:
+    friend class SignalProcessor;
+    std::shared_lock<std::shared_mutex> mAlive;
+    std::unique_lock<std::mutex> mPause;
+    AnalysisWorker* mWorker = nullptr;
+};
+
+#endif //OJAS_ANALYSIS_WORKER_H
@@ -0,0 +1,69 @@
+// app/src/main/cpp/arena.h
+#ifndef OJAS_ARENA_H
+#define OJAS_ARENA_H
+
+#include <cstdlib>
+#include <new>
+#include "ring_buffer.h"
+
+/**
+ * Single cache-line aligned block carved up with a bump pointer.
+ *
+ * Owners size the arena once (summing bytesFor() over everything they will
+ * place in it), then hand out sub-buffers with allocate(). Nothing is freed
+ * individually; reset() drops every previous allocation at once.
+ */
+class Arena {
+public:
+    Arena() = default;
+
+    ~Arena() {
+        free(mBase);
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Bytes one allocate<T>(count) call consumes, including alignment padding
+    template <typename T>
+    static size_t bytesFor(size_t count) {
+        return (sizeof(T) * count + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
+    }
+
+    // Drop all allocations and make room for `capacity` bytes
+    void reset(size_t capacity) {
+        free(mBase);
+        mBase = nullptr;
+        mCapacity = 0;
+        mUsed = 0;
+        if (capacity == 0) return;
+
+        void* mem = nullptr;
+        if (posix_memalign(&mem, kCacheLineSize, capacity) != 0) {
+            throw std::bad_alloc();
+        }
+        mBase = static_cast<char*>(mem);
+        mCapacity = capacity;
+    }
+
+    template <typename T>
+    T* allocate(size_t count) {
+        size_t bytes = bytesFor<T>(count);
+        if (mUsed + bytes > mCapacity) {
+            throw std::bad_alloc();
+        }
+        T* ptr = reinterpret_cast<T*>(mBase + mUsed);
+        mUsed += bytes;
+        return ptr;
+    }
+
+    size_t used() const { return mUsed; }
+    size_t capacity() const { return mCapacity; }
+
+private:
+    char* mBase = nullptr;
+    size_t mCapacity = 0;
+    size_t mUsed = 0;
+};
+
+#endif //OJAS_ARENA_H
@@ -0,0 +1,42 @@
+// app/src/main/cpp/bench/bench_ingest.cpp
+// Per-sample ingest cost of SignalProcessor::addSample as the window grows,
+// against the erase-front std::vector window it replaced.
+#include "bench_util.h"
+#include "ring_buffer.h"
+#include "signal_processor.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+int main() {
+    const float fs = 30.0f;
+    const int samples = 1 << 16;
+    printf("%8s %16s %16s %18s\n", "N", "addSample ns", "ring push ns", "vector erase ns");
+    for (int n : {300, 1024, 2048, 4096, 8192}) {
+        // Full window first, so every timed push also evicts
+        SignalProcessor processor(n, fs);
+        long t = 0;
+        for (int i = 0; i < n; ++i, t += 33) processor.addSample(sinf(i * 0.1f), t);
+        double ingest = nanosPer([&] {
+            for (int i = 0; i < samples; ++i, t += 33) processor.addSample(sinf(i * 0.1f), t);
+        }, samples);
+
+        RingBuffer<float> ring(n);
+        double push = nanosPer([&] {
+            for (int i = 0; i < samples; ++i) ring.push(static_cast<float>(i));
+            keep(ring.newest());
+        }, samples);
+
+        std::vector<float> window(n, 0.0f);
+        double erase = nanosPer([&] {
+            for (int i = 0; i < samples / 16; ++i) {
+                window.erase(window.begin());
+                window.push_back(static_cast<float>(i));
+            }
+            keep(window.back());
+        }, samples / 16);
+
+        printf("%8d %16.1f %16.2f %18.1f\n", n, ingest, push, erase);
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+// app/src/main/cpp/bench/bench_row_tiles.cpp
+// Where row tiling starts to pay: YUV ROI statistics (the per-frame camera
+// kernel) over square ROIs of a synthetic 4K frame, inline against the
+// frame pool forced to tile, for 1 .. N threads (N from the command line,
+// default the core count). Prints the measured break-even per thread count
+// next to ThreadPool::calibrate()'s, which models it from the pool's idle
+// wake-up and the kernel's cost per pixel measured here; the app calibrates
+// with roiNanosPerPixel(), printed alongside.
+#include "bench_util.h"
+#include "roi_extractor.h"
+#include "thread_pool.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const int width = 3840;
+    const int height = 2160;
+    const int maxThreads = argc > 1 ? std::max(1, atoi(argv[1]))
+                                    : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    // Semi-planar 4:2:0 with skin-like noise, as the camera delivers it
+    std::mt19937 rng(18);
+    std::vector<uint8_t> luma(static_cast<size_t>(width) * height);
+    std::vector<uint8_t> chroma(static_cast<size_t>(width) * height / 2 + 1);
+    for (auto& b : luma) b = static_cast<uint8_t>(90 + rng() % 100);
+    for (auto& b : chroma) b = static_cast<uint8_t>(110 + rng() % 50);
+    const size_t chromaBytes = chroma.size() - 1;
+    YuvFrame frame{{luma.data(), luma.size(), width, height, width, 1},
+                   {chroma.data(), chromaBytes, width / 2, height / 2, width, 2},
+                   {chroma.data() + 1, chromaBytes, width / 2, height / 2, width, 2},
+                   0};
+    static const SkinThresholds kSkin;
+
+    std::vector<ThreadPool*> pools;
+    for (int t = 2; t <= maxThreads; ++t) {
+        pools.push_back(new ThreadPool(t));
+        pools.back()->setMinParallelPixels(0);
+    }
+
+    const int sides[] = {64, 128, 181, 256, 362, 512, 724, 1024, 1448, 2048};
+    const int sizes = sizeof(sides) / sizeof(sides[0]);
+    std::vector<double> inlineUs(sizes);
+    std::vector<std::vector<double>> pooledUs(pools.size(), std::vector<double>(sizes));
+
+    printf("%10s %10s", "pixels", "inline us");
+    for (int t = 2; t <= maxThreads; ++t) printf("   %2d thr us", t);
+    printf("\n");
+    for (int s = 0; s < sizes; ++s) {
+        const float side = static_cast<float>(sides[s]);
+        const float x = (width - side) / 2, y = (height - side) / 2;
+        const float square[] = {x, y, x + side, y, x + side, y + side, x, y + side};
+        const int calls = std::max(3, 2000000 / (sides[s] * sides[s]));
+
+        auto timed = [&](ThreadPool* pool) {
+            return nanosPer([&] {
+                for (int c = 0; c < calls; ++c) keep(convexRoiStatsYuv(frame, square, 4, pool, &kSkin));
+            }, calls) / 1000.0;
+        };
+        inlineUs[s] = timed(nullptr);
+        printf("%10d %10.1f", sides[s] * sides[s], inlineUs[s]);
+        for (size_t p = 0; p < pools.size(); ++p) {
+            pooledUs[p][s] = timed(pools[p]);
+            printf(" %11.1f", pooledUs[p][s]);
+        }
+        printf("\n");
+    }
+
+    // Kernel cost per pixel from the largest ROI, where fixed costs vanish
+    const double nsPerPixel = inlineUs[sizes - 1] * 1000.0 /
+                              (static_cast<double>(sides[sizes - 1]) * sides[sizes - 1]);
+    printf("\ninline kernel: %.3f ns/pixel (roiNanosPerPixel %.3f)\n", nsPerPixel, roiNanosPerPixel());
+    printf("%8s %20s %20s\n", "threads", "measured break-even", "calibrated threshold");
+    for (size_t p = 0; p < pools.size(); ++p) {
+        int measured = -1;
+        for (int s = 0; s < sizes && measured < 0; ++s) {
+            if (pooledUs[p][s] < inlineUs[s]) measured = sides[s] * sides[s];
+        }
+        printf("%8d", static_cast<int>(p) + 2);
+        if (measured < 0) {
+            printf(" %20s", "none");
+        } else {
+            printf(" %20d", measured);
+        }
+        printf(" %20ld\n", pools[p]->calibrate(nsPerPixel));
+    }
+
+    for (ThreadPool* pool : pools) delete pool;
+    return 0;
+}
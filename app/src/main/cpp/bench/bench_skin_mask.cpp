@@ -0,0 +1,75 @@
+// app/src/main/cpp/bench/bench_skin_mask.cpp
+// Skin-masked YUV ROI statistics on a 640x480 camera frame, single thread,
+// against the 60 fps budget: a hull over the whole frame (the worst case,
+// every pixel classified) and three face-sized ROIs measured in one pass (the
+// per-frame FaceTracker call), plain and masked, semi-planar (NV21) and
+// planar (I420) chroma. On arm64 cores with the dot-product extension the
+// masked kernels run again with it off, to show both paths.
+#include "bench_util.h"
+#include "frame_stats.h"
+#include "roi_extractor.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static const double kBudgetMs = 1000.0 / 60.0;
+
+int main() {
+    const int width = 640;
+    const int height = 480;
+    const int calls = 200;
+
+    // Skin-like noise with a share of out-of-box pixels, so the mask rejects some
+    std::mt19937 rng(25);
+    std::vector<uint8_t> luma(static_cast<size_t>(width) * height);
+    std::vector<uint8_t> chroma(static_cast<size_t>(width) * height / 2 + 1);
+    for (auto& b : luma) b = static_cast<uint8_t>(30 + rng() % 220);
+    for (auto& b : chroma) b = static_cast<uint8_t>(70 + rng() % 120);
+    const size_t semiBytes = chroma.size() - 1;
+    const size_t planeBytes = static_cast<size_t>(width / 2) * (height / 2);
+    PlaneView y{luma.data(), luma.size(), width, height, width, 1};
+    const YuvFrame nv21{y,
+                        {chroma.data() + 1, semiBytes, width / 2, height / 2, width, 2},
+                        {chroma.data(), semiBytes, width / 2, height / 2, width, 2},
+                        0};
+    const YuvFrame i420{y,
+                        {chroma.data(), planeBytes, width / 2, height / 2, width / 2, 1},
+                        {chroma.data() + planeBytes, planeBytes, width / 2, height / 2, width / 2, 1},
+                        0};
+    static const SkinThresholds kSkin;
+
+    const float w = width, h = height;
+    const float whole[] = {0, 0, w, 0, w, h, 0, h};
+    // Forehead and cheeks of a face filling about half the frame height
+    const float face[] = {250, 90, 390, 90, 400, 150, 240, 150,
+                          230, 220, 300, 210, 300, 300, 240, 290,
+                          340, 210, 410, 220, 400, 290, 340, 300};
+    const int faceStarts[] = {0, 4, 8, 12};
+    RoiStats faceStats[3];
+
+    std::vector<bool> modes = {dotProdEnabled()};
+    if (modes[0]) modes.push_back(false);
+
+    printf("%-6s %-6s %-8s %12s %12s %10s\n", "chroma", "mask", "UDOT", "whole ms", "face us", "budget %");
+    for (bool dot : modes) {
+        setDotProdEnabled(dot);
+        for (const YuvFrame* frame : {&nv21, &i420}) {
+            for (const SkinThresholds* skin : {static_cast<const SkinThresholds*>(nullptr), &kSkin}) {
+                const double wholeMs = nanosPer([&] {
+                    for (int c = 0; c < calls; ++c) keep(convexRoiStatsYuv(*frame, whole, 4, nullptr, skin));
+                }, calls) / 1e6;
+                const double faceUs = nanosPer([&] {
+                    for (int c = 0; c < calls; ++c) {
+                        convexRoiStatsYuv(*frame, face, faceStarts, 3, faceStats, nullptr, skin);
+                        keep(faceStats[0]);
+                    }
+                }, calls) / 1e3;
+                printf("%-6s %-6s %-8s %12.3f %12.1f %9.1f%%\n",
+                       frame == &nv21 ? "NV21" : "I420", skin ? "skin" : "none", dot ? "on" : "off",
+                       wholeMs, faceUs, 100.0 * wholeMs / kBudgetMs);
+            }
+        }
+    }
+    printf("\n60 fps budget: %.1f ms per frame; budget %% is the whole-frame hull\n", kBudgetMs);
+    return 0;
+}
@@ -0,0 +1,31 @@
+// app/src/main/cpp/bench/bench_util.h
+#ifndef OJAS_BENCH_UTIL_H
+#define OJAS_BENCH_UTIL_H
+
+#include <algorithm>
+#include <chrono>
+
+// Keeps a result alive so the optimizer cannot drop the timed work
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * Best-of-`repeats` wall time of fn(), in nanoseconds per `unitsPerCall`
+ * (e.g. samples or pixels handled by one call). The minimum is the least
+ * disturbed run, which is what a kernel-to-kernel comparison wants.
+ */
+template <typename Fn>
+double nanosPer(Fn fn, double unitsPerCall, int repeats = 7) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    return best / unitsPerCall;
+}
+
+#endif //OJAS_BENCH_UTIL_H
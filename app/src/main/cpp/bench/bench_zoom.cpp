@@ -0,0 +1,67 @@
+// app/src/main/cpp/bench/bench_zoom.cpp
+// Cost of one HR-band spectrum at a given grid spacing: the chirp-z zoom
+// transform against a real FFT zero-padded until its bins are that fine.
+#include "arena.h"
+#include "bench_util.h"
+#include "chirp_z.h"
+#include "kiss_fftr.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static constexpr float kMinHrHz = 0.75f;
+static constexpr float kMaxHrHz = 3.33f;
+
+int main() {
+    const float fs = 30.0f;
+    const int n = 300;
+    const int calls = 200;
+
+    std::vector<float> window(n);
+    for (int i = 0; i < n; ++i) {
+        float hamming = 0.54f - 0.46f * cosf(2.0f * M_PI * i / (n - 1));
+        window[i] = hamming * sinf(2.0f * M_PI * 1.2f * i / fs);
+    }
+
+    printf("%10s %10s %14s %12s %14s %8s\n",
+           "step BPM", "points", "chirp-z us", "FFT length", "padded FFT us", "ratio");
+    for (float bpmStep : {2.0f, 1.0f, 0.5f, 0.25f, 0.1f}) {
+        const float stepHz = bpmStep / 60.0f;
+        const int points = static_cast<int>((kMaxHrHz - kMinHrHz) / stepHz) + 1;
+
+        Arena arena;
+        arena.reset(ChirpZ::arenaBytes(n, points));
+        ChirpZ zoom(n, points, kMinHrHz, stepHz, fs, arena);
+        std::vector<float> zoomOut(points);
+        double zoomUs = nanosPer([&] {
+            for (int c = 0; c < calls; ++c) zoom.magnitudes(window.data(), n, zoomOut.data());
+            keep(zoomOut[0]);
+        }, calls) / 1000.0;
+
+        // Real FFT with bin spacing <= stepHz; only the band bins are converted
+        int length = static_cast<int>(ceilf(fs / stepHz));
+        length += length & 1;
+        kiss_fftr_cfg cfg = kiss_fftr_alloc(length, 0, nullptr, nullptr);
+        std::vector<float> in(length, 0.0f);
+        std::vector<kiss_fft_cpx> out(length / 2 + 1);
+        std::vector<float> fftOut(points);
+        const int first = static_cast<int>(kMinHrHz * length / fs);
+        double fftUs = nanosPer([&] {
+            for (int c = 0; c < calls; ++c) {
+                std::copy(window.begin(), window.end(), in.begin());
+                std::fill(in.begin() + n, in.end(), 0.0f);
+                kiss_fftr(cfg, in.data(), out.data());
+                for (int k = 0; k < points && first + k < length / 2 + 1; ++k) {
+                    const kiss_fft_cpx& x = out[first + k];
+                    fftOut[k] = sqrtf(x.r * x.r + x.i * x.i);
+                }
+            }
+            keep(fftOut[0]);
+        }, calls) / 1000.0;
+        kiss_fftr_free(cfg);
+
+        printf("%10.2f %10d %14.1f %12d %14.1f %7.1fx\n",
+               bpmStep, points, zoomUs, length, fftUs, fftUs / zoomUs);
+    }
+    return 0;
+}
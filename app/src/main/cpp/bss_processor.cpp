@@ -0,0 +1,233 @@
+// app/src/main/cpp/bss_processor.cpp
+#include "bss_processor.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr double kTolerance = 1e-6;
+
+// Row-major 3x3 product c = a * b
+static void multiply3(const double* a, const double* b, double* c) {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            c[3 * i + j] = a[3 * i] * b[j] + a[3 * i + 1] * b[3 + j] + a[3 * i + 2] * b[6 + j];
+        }
+    }
+}
+
+// Cyclic Jacobi on a symmetric 3x3 matrix: a becomes diagonal (the
+// eigenvalues), v collects the eigenvectors as columns
+static void symmetricEigen3(double* a, double* v) {
+    for (int i = 0; i < 9; ++i) v[i] = (i % 4 == 0) ? 1.0 : 0.0;
+    for (int sweep = 0; sweep < 16; ++sweep) {
+        double off = a[1] * a[1] + a[2] * a[2] + a[5] * a[5];
+        if (off < 1e-24) break;
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                double apq = a[3 * p + q];
+                if (fabs(apq) < 1e-300) continue;
+                double theta = (a[3 * q + q] - a[3 * p + p]) / (2.0 * apq);
+                double t = (theta >= 0.0 ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta * theta + 1.0));
+                double c = 1.0 / sqrt(t * t + 1.0), s = t * c;
+                // a <- J^T a J with the rotation J in the (p, q) plane
+                for (int k = 0; k < 3; ++k) {
+                    double akp = a[3 * k + p], akq = a[3 * k + q];
+                    a[3 * k + p] = c * akp - s * akq;
+                    a[3 * k + q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    double apk = a[3 * p + k], aqk = a[3 * q + k];
+                    a[3 * p + k] = c * apk - s * aqk;
+                    a[3 * q + k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    double vkp = v[3 * k + p], vkq = v[3 * k + q];
+                    v[3 * k + p] = c * vkp - s * vkq;
+                    v[3 * k + q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+}
+
+// w <- (w w^T)^(-1/2) w, so the rows of w are orthonormal
+static void decorrelate(double* w) {
+    double m[9], e[9], wt[9];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) wt[3 * j + i] = w[3 * i + j];
+    }
+    multiply3(w, wt, m);
+    symmetricEigen3(m, e);
+    double scaled[9], root[9], et[9];
+    for (int i = 0; i < 3; ++i) {
+        double d = 1.0 / sqrt(std::max(m[4 * i], 1e-12));
+        for (int k = 0; k < 3; ++k) {
+            scaled[3 * k + i] = e[3 * k + i] * d;
+            et[3 * i + k] = e[3 * k + i];
+        }
+    }
+    multiply3(scaled, et, root);
+    double out[9];
+    multiply3(root, w, out);
+    std::copy(out, out + 9, w);
+}
+
+BssProcessor::BssProcessor(int bufferSize, float samplingRate)
+        : mBufferSize(std::max(2, bufferSize)), mSamplingRate(samplingRate),
+          mScorer(3, mBufferSize, samplingRate) {
+    mPaddedLength = (mBufferSize + 3) & ~3;
+    for (auto& ring : mRgb) ring = std::make_unique<RingBuffer<float>>(mBufferSize);
+    mArena.reset(2 * Arena::bytesFor<float>(3 * static_cast<size_t>(mPaddedLength)));
+    mWhite = mArena.allocate<float>(3 * static_cast<size_t>(mPaddedLength));
+    mComponents = mArena.allocate<float>(3 * static_cast<size_t>(mPaddedLength));
+    reset();
+}
+
+void BssProcessor::reset() {
+    for (auto& ring : mRgb) ring->clear();
+    mScorer.reset();
+    std::fill(mWhite, mWhite + 3 * static_cast<size_t>(mPaddedLength), 0.0f);
+    std::fill(mComponents, mComponents + 3 * static_cast<size_t>(mPaddedLength), 0.0f);
+    mHaveUnmixing = false;
+    mSelected = 0;
+    mComponentLength = 0;
+    mIterations = 0;
+    mHeartRate = 0.0f;
+}
+
+void BssProcessor::addFrame(float r, float g, float b) {
+    mRgb[0]->push(r);
+    mRgb[1]->push(g);
+    mRgb[2]->push(b);
+}
+
+bool BssProcessor::whiten(int n) {
+    // z-scored traces and their covariance (the correlation matrix)
+    double cov[9] = {};
+    for (int c = 0; c < 3; ++c) {
+        const float* x = mRgb[c]->data();
+        double sum = 0.0, sumSq = 0.0;
+        for (int i = 0; i < n; ++i) {
+            sum += x[i];
+            sumSq += static_cast<double>(x[i]) * x[i];
+        }
+        double mean = sum / n;
+        double var = sumSq / n - mean * mean;
+        if (var <= 1e-12) return false;
+        float m = static_cast<float>(mean), inv = static_cast<float>(1.0 / sqrt(var));
+        float* z = mComponents + c * mPaddedLength;
+        for (int i = 0; i < n; ++i) z[i] = (x[i] - m) * inv;
+    }
+    for (int p = 0; p < 3; ++p) {
+        for (int q = p; q < 3; ++q) {
+            const float* a = mComponents + p * mPaddedLength;
+            const float* b = mComponents + q * mPaddedLength;
+            double dot = 0.0;
+            for (int i = 0; i < n; ++i) dot += a[i] * b[i];
+            cov[3 * p + q] = cov[3 * q + p] = dot / n;
+        }
+    }
+
+    // PCA whitening V = D^(-1/2) E^T; a near-singular direction (two channels
+    // moving together exactly) is dropped to zero rather than amplified
+    double e[9];
+    symmetricEigen3(cov, e);
+    double* v = mWhitening;
+    for (int i = 0; i < 3; ++i) {
+        bool kept = cov[4 * i] > 1e-6;
+        double d = kept ? 1.0 / sqrt(cov[4 * i]) : 0.0;
+        double root = kept ? sqrt(cov[4 * i]) : 0.0;
+        for (int k = 0; k < 3; ++k) {
+            v[3 * i + k] = e[3 * k + i] * d;
+            mColouring[3 * k + i] = e[3 * k + i] * root;
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        float* out = mWhite + i * mPaddedLength;
+        const float* z0 = mComponents;
+        const float* z1 = z0 + mPaddedLength;
+        const float* z2 = z1 + mPaddedLength;
+        float v0 = static_cast<float>(v[3 * i]), v1 = static_cast<float>(v[3 * i + 1]);
+        float v2 = static_cast<float>(v[3 * i + 2]);
+        for (int t = 0; t < n; ++t) out[t] = v0 * z0[t] + v1 * z1[t] + v2 * z2[t];
+    }
+    return true;
+}
+
+void BssProcessor::unmix(int n) {
+    // Previous window's unmixing seen through this window's whitening
+    double w[9];
+    if (mHaveUnmixing) {
+        multiply3(mUnmixing, mColouring, w);
+    } else {
+        for (int i = 0; i < 9; ++i) w[i] = (i % 4 == 0) ? 1.0 : 0.0;
+    }
+    decorrelate(w);
+
+    const float* z[3] = {mWhite, mWhite + mPaddedLength, mWhite + 2 * mPaddedLength};
+    mIterations = 0;
+    while (mIterations < kMaxIterations) {
+        ++mIterations;
+        // w_i <- E[z g(w_i . z)] - E[g'(w_i . z)] w_i, g = tanh
+        double next[9];
+        for (int r = 0; r < 3; ++r) {
+            float w0 = static_cast<float>(w[3 * r]), w1 = static_cast<float>(w[3 * r + 1]);
+            float w2 = static_cast<float>(w[3 * r + 2]);
+            double gz[3] = {0.0, 0.0, 0.0}, dg = 0.0;
+            for (int t = 0; t < n; ++t) {
+                float g = tanhf(w0 * z[0][t] + w1 * z[1][t] + w2 * z[2][t]);
+                gz[0] += g * z[0][t];
+                gz[1] += g * z[1][t];
+                gz[2] += g * z[2][t];
+                dg += 1.0f - g * g;
+            }
+            for (int k = 0; k < 3; ++k) next[3 * r + k] = (gz[k] - dg * w[3 * r + k]) / n;
+        }
+        decorrelate(next);
+
+        // Converged when every row keeps its direction (up to sign)
+        double change = 0.0;
+        for (int r = 0; r < 3; ++r) {
+            double dot = next[3 * r] * w[3 * r] + next[3 * r + 1] * w[3 * r + 1] +
+                         next[3 * r + 2] * w[3 * r + 2];
+            change = std::max(change, 1.0 - fabs(dot));
+        }
+        std::copy(next, next + 9, w);
+        if (change < kTolerance) break;
+    }
+
+    multiply3(w, mWhitening, mUnmixing);
+    mHaveUnmixing = true;
+
+    for (int r = 0; r < 3; ++r) {
+        float* out = mComponents + r * mPaddedLength;
+        float w0 = static_cast<float>(w[3 * r]), w1 = static_cast<float>(w[3 * r + 1]);
+        float w2 = static_cast<float>(w[3 * r + 2]);
+        for (int t = 0; t < n; ++t) out[t] = w0 * z[0][t] + w1 * z[1][t] + w2 * z[2][t];
+    }
+}
+
+float BssProcessor::computeHeartRate() {
+    int n = mRgb[0]->size();
+    if (n < mSamplingRate * 3) return 0.0f;
+    if (!whiten(n)) return mHeartRate;
+    unmix(n);
+    mComponentLength = n;
+
+    // One batched band DFT scores all three components
+    mScorer.setWindow(mComponents, mPaddedLength, n);
+    const float* rates = mScorer.computeHeartRates();
+    const float* peak = mScorer.getPeakFraction();
+    mSelected = static_cast<int>(std::max_element(peak, peak + 3) - peak);
+
+    // ICA leaves the sign free; orient the component so it reads like the green trace
+    float* selected = mComponents + mSelected * mPaddedLength;
+    const float* green = mRgb[1]->data();
+    double corr = 0.0;
+    for (int t = 0; t < n; ++t) corr += selected[t] * green[t];
+    if (corr < 0.0) {
+        for (int t = 0; t < n; ++t) selected[t] = -selected[t];
+    }
+
+    if (rates[mSelected] > 0.0f) mHeartRate = rates[mSelected];
+    return mHeartRate;
+}
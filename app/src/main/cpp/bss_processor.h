@@ -0,0 +1,73 @@
+// app/src/main/cpp/bss_processor.h
+#ifndef OJAS_BSS_PROCESSOR_H
+#define OJAS_BSS_PROCESSOR_H
+
+#include <memory>
+#include "arena.h"
+#include "multi_channel_processor.h"
+#include "ring_buffer.h"
+
+/**
+ * Blind source separation of the windowed R, G, B traces (Poh et al. 2010).
+ *
+ * Each analysis z-scores the three traces, whitens them with PCA (3x3
+ * eigendecomposition) and unmixes them with symmetric FastICA (log-cosh
+ * contrast). The unmixing matrix is warm-started from the previous window,
+ * carried in z-scored coordinates because the PCA basis can reorder or flip
+ * between windows, so it usually converges in a few iterations and
+ * component order is stable. The three components are then handed to a
+ * 3-channel MultiChannelProcessor, whose batched HR-band DFT scores them all
+ * in one pass. The heart rate comes from the component whose HR-band power is most
+ * concentrated in its peak: components are unit-variance, so total band
+ * power also rewards broadband motion leaking into the band.
+ *
+ * All 3x3 work is closed-form on the stack; window and component buffers
+ * are allocated once, so computeHeartRate() does not allocate.
+ */
+class BssProcessor {
+public:
+    BssProcessor(int bufferSize, float samplingRate);
+
+    void addFrame(float r, float g, float b);
+
+    // BPM from the selected component (0 until 3 s are in)
+    float computeHeartRate();
+
+    // Selected component over the window (unit variance, sign matched to
+    // green), and its index; valid after computeHeartRate()
+    const float* getComponent() const { return mComponents + mSelected * mPaddedLength; }
+    int getSelectedComponent() const { return mSelected; }
+    int getComponentLength() const { return mComponentLength; }
+
+    // FastICA iterations used by the last computeHeartRate(), at most kMaxIterations
+    static constexpr int kMaxIterations = 32;
+    int getIterations() const { return mIterations; }
+
+    int getSampleCount() const { return mRgb[0]->size(); }
+    void reset();
+
+private:
+    int mBufferSize;
+    float mSamplingRate;
+    int mPaddedLength;
+
+    std::unique_ptr<RingBuffer<float>> mRgb[3];
+    MultiChannelProcessor mScorer;
+
+    Arena mArena;
+    float* mWhite;        // whitened traces, channel c at c * mPaddedLength
+    float* mComponents;   // separated components, same layout
+    double mWhitening[9]; // V, z-scored traces to whitened ones
+    double mColouring[9]; // V's (pseudo-)inverse
+    double mUnmixing[9];  // W V: z-scored traces to components, the warm start
+    bool mHaveUnmixing = false;
+    int mSelected = 0;
+    int mComponentLength = 0;
+    int mIterations = 0;
+    float mHeartRate = 0.0f;
+
+    bool whiten(int n);
+    void unmix(int n);
+};
+
+#endif //OJAS_BSS_PROCESSOR_H
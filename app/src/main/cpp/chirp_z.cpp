@@ -0,0 +1,97 @@
+// app/src/main/cpp/chirp_z.cpp
+#include "chirp_z.h"
+#include <algorithm>
+#include <cmath>
+
+// Smallest power of two >= n. The vendored kiss_fft has butterflies for
+// radix 2 and 4 only; factors 3 and 5 fall back to kf_bfly_generic, which is
+// O(p^2) per butterfly, so 2/3/5-smooth lengths are not the fast ones here.
+static int nextFastFftSize(int n) {
+    int size = 1;
+    while (size < n) size <<= 1;
+    return size;
+}
+
+static size_t planBytes(int nfft) {
+    size_t bytes = 0;
+    kiss_fft_alloc(nfft, 0, nullptr, &bytes);
+    return bytes;
+}
+
+size_t ChirpZ::arenaBytes(int inputLength, int points) {
+    int fftLength = nextFastFftSize(inputLength + points - 1);
+    return Arena::bytesFor<char>(planBytes(fftLength)) +
+           Arena::bytesFor<kiss_fft_cpx>(inputLength) +
+           3 * Arena::bytesFor<kiss_fft_cpx>(fftLength);
+}
+
+ChirpZ::ChirpZ(int inputLength, int points, float startHz, float stepHz, float samplingRate,
+               Arena& arena)
+        : mInputLength(inputLength), mPoints(points),
+          mStartHz(startHz), mStepHz(stepHz) {
+
+    mFftLength = nextFastFftSize(inputLength + points - 1);
+    size_t planSize = planBytes(mFftLength);
+    mFftCfg = kiss_fft_alloc(mFftLength, 0, arena.allocate<char>(planSize), &planSize);
+    mPremul = arena.allocate<kiss_fft_cpx>(inputLength);
+    mKernelFft = arena.allocate<kiss_fft_cpx>(mFftLength);
+    mWork = arena.allocate<kiss_fft_cpx>(mFftLength);
+    mWorkOut = arena.allocate<kiss_fft_cpx>(mFftLength);
+
+    // chirp[n] = e^{-jπ w n^2}, w = step / fs (normalized grid spacing)
+    const double w = static_cast<double>(stepHz) / samplingRate;
+    const double a = static_cast<double>(startHz) / samplingRate;
+    auto chirpPhase = [w](long n) {
+        // Reduce n^2 * w modulo 2 before scaling to keep the phase accurate
+        return -M_PI * fmod(static_cast<double>(n) * n * w, 2.0);
+    };
+
+    for (int n = 0; n < inputLength; ++n) {
+        double phase = chirpPhase(n) - 2.0 * M_PI * fmod(a * n, 1.0);
+        mPremul[n].r = static_cast<float>(cos(phase));
+        mPremul[n].i = static_cast<float>(sin(phase));
+    }
+
+    // Convolution kernel conj(chirp[n]) for n in (-inputLength, points), stored circularly
+    std::fill(mWork, mWork + mFftLength, kiss_fft_cpx{0.0f, 0.0f});
+    for (int n = 0; n < points; ++n) {
+        double phase = -chirpPhase(n);
+        mWork[n].r = static_cast<float>(cos(phase));
+        mWork[n].i = static_cast<float>(sin(phase));
+    }
+    for (int n = 1; n < inputLength; ++n) {
+        double phase = -chirpPhase(n);
+        mWork[mFftLength - n].r = static_cast<float>(cos(phase));
+        mWork[mFftLength - n].i = static_cast<float>(sin(phase));
+    }
+    kiss_fft(mFftCfg, mWork, mKernelFft);
+}
+
+void ChirpZ::magnitudes(const float* input, int count, float* out) {
+    count = std::min(count, mInputLength);
+
+    // 1. Modulate and chirp the input
+    for (int n = 0; n < count; ++n) {
+        mWork[n].r = input[n] * mPremul[n].r;
+        mWork[n].i = input[n] * mPremul[n].i;
+    }
+    std::fill(mWork + count, mWork + mFftLength, kiss_fft_cpx{0.0f, 0.0f});
+
+    // 2. Circular convolution with the chirp kernel
+    kiss_fft(mFftCfg, mWork, mWorkOut);
+    for (int i = 0; i < mFftLength; ++i) {
+        float re = mWorkOut[i].r * mKernelFft[i].r - mWorkOut[i].i * mKernelFft[i].i;
+        float im = mWorkOut[i].r * mKernelFft[i].i + mWorkOut[i].i * mKernelFft[i].r;
+        // Conjugate so the forward plan computes the inverse transform
+        mWorkOut[i].r = re;
+        mWorkOut[i].i = -im;
+    }
+    kiss_fft(mFftCfg, mWorkOut, mWork);
+
+    // 3. The output post-chirp has unit modulus, so only the 1/L scale
+    //    of the inverse transform affects the magnitude
+    const float scale = 1.0f / mFftLength;
+    for (int k = 0; k < mPoints; ++k) {
+        out[k] = scale * sqrtf(mWork[k].r * mWork[k].r + mWork[k].i * mWork[k].i);
+    }
+}
@@ -0,0 +1,47 @@
+// app/src/main/cpp/chirp_z.h
+#ifndef OJAS_CHIRP_Z_H
+#define OJAS_CHIRP_Z_H
+
+#include "arena.h"
+#include "kiss_fft.h"
+
+/**
+ * Chirp-z (zoom) transform of a real sequence, evaluated at `points`
+ * frequencies startHz, startHz + stepHz, ... using Bluestein's algorithm.
+ *
+ * The cost is two complex FFTs of length L >= inputLength + points - 1,
+ * independent of how fine stepHz is, so a narrow band can be sampled on a
+ * grid that would need a far longer zero-padded FFT.
+ */
+class ChirpZ {
+public:
+    // Plan and work buffers are carved from `arena`, which must have arenaBytes() free
+    ChirpZ(int inputLength, int points, float startHz, float stepHz, float samplingRate,
+           Arena& arena);
+    static size_t arenaBytes(int inputLength, int points);
+
+    ChirpZ(const ChirpZ&) = delete;
+    ChirpZ& operator=(const ChirpZ&) = delete;
+
+    // count <= inputLength samples; the rest of the input is taken as zero
+    void magnitudes(const float* input, int count, float* out);
+
+    int points() const { return mPoints; }
+    float startHz() const { return mStartHz; }
+    float stepHz() const { return mStepHz; }
+
+private:
+    int mInputLength;
+    int mPoints;
+    int mFftLength;
+    float mStartHz;
+    float mStepHz;
+
+    kiss_fft_cfg mFftCfg;
+    kiss_fft_cpx* mPremul;     // e^{-j2πf0n/fs} * chirp[n], n < inputLength
+    kiss_fft_cpx* mKernelFft;  // FFT of the conjugate chirp, length L
+    kiss_fft_cpx* mWork;
+    kiss_fft_cpx* mWorkOut;
+};
+
+#endif //OJAS_CHIRP_Z_H
@@ -0,0 +1,144 @@
+// app/src/main/cpp/chrom_processor.cpp
+#include "chrom_processor.h"
+#include <algorithm>
+#include <cmath>
+
+// Pass band of the chrominance signals (42 - 240 BPM), as in the CHROM paper
+static constexpr float kBandLowHz = 0.7f;
+static constexpr float kBandHighHz = 4.0f;
+
+static int roundUp4(int n) {
+    return (n + 3) & ~3;
+}
+
+// RBJ cookbook Butterworth (Q = 1/sqrt(2)) section at `cutoffHz`
+static void designSection(float cutoffHz, float samplingRate, bool highPass,
+                          float* b0, float* b1, float* b2, float* a1, float* a2) {
+    double w0 = 2.0 * M_PI * std::min(cutoffHz, 0.45f * samplingRate) / samplingRate;
+    double cosW = cos(w0);
+    double alpha = sin(w0) / (2.0 * M_SQRT1_2);
+    double a0 = 1.0 + alpha;
+    double edge = highPass ? (1.0 + cosW) / 2.0 : (1.0 - cosW) / 2.0;
+    *b0 = static_cast<float>(edge / a0);
+    *b1 = static_cast<float>((highPass ? -2.0 : 2.0) * edge / a0);
+    *b2 = *b0;
+    *a1 = static_cast<float>(-2.0 * cosW / a0);
+    *a2 = static_cast<float>((1.0 - alpha) / a0);
+}
+
+ChromProcessor::ChromProcessor(int channels, float samplingRate, float windowSeconds)
+        : mChannels(std::max(1, channels)) {
+    mLanes = roundUp4(mChannels);
+    mWindow = std::max(2, static_cast<int>(lroundf(windowSeconds * samplingRate)));
+
+    for (int f = 0; f < 2; ++f) {
+        Biquad& q = mFilters[f];
+        designSection(f == 0 ? kBandLowHz : kBandHighHz, samplingRate, f == 0,
+                      &q.b0, &q.b1, &q.b2, &q.a1, &q.a2);
+    }
+
+    size_t lanes = mLanes;
+    mArena.reset(Arena::bytesFor<float>(3 * mWindow * lanes) +
+                 Arena::bytesFor<double>(3 * lanes) +
+                 Arena::bytesFor<float>(2 * mWindow * lanes) +
+                 Arena::bytesFor<double>(4 * lanes) +
+                 Arena::bytesFor<float>(8 * lanes) +
+                 4 * Arena::bytesFor<float>(lanes));
+
+    mRgb = mArena.allocate<float>(3 * mWindow * lanes);
+    mRgbSums = mArena.allocate<double>(3 * lanes);
+    mFiltered = mArena.allocate<float>(2 * mWindow * lanes);
+    mMoments = mArena.allocate<double>(4 * lanes);
+    mState = mArena.allocate<float>(8 * lanes);
+    mX = mArena.allocate<float>(lanes);
+    mY = mArena.allocate<float>(lanes);
+    mAlpha = mArena.allocate<float>(lanes);
+    mResults = mArena.allocate<float>(lanes);
+    reset();
+}
+
+void ChromProcessor::reset() {
+    mHead = 0;
+    mSize = 0;
+    size_t lanes = mLanes;
+    std::fill(mRgb, mRgb + 3 * mWindow * lanes, 0.0f);
+    std::fill(mRgbSums, mRgbSums + 3 * lanes, 0.0);
+    std::fill(mFiltered, mFiltered + 2 * mWindow * lanes, 0.0f);
+    std::fill(mMoments, mMoments + 4 * lanes, 0.0);
+    std::fill(mState, mState + 8 * lanes, 0.0f);
+    std::fill(mX, mX + lanes, 0.0f);
+    std::fill(mY, mY + lanes, 0.0f);
+    std::fill(mAlpha, mAlpha + lanes, 0.0f);
+    std::fill(mResults, mResults + lanes, 0.0f);
+}
+
+const float* ChromProcessor::process(const float* rgb) {
+    const bool full = mSize == mWindow;
+    const int count = full ? mWindow : mSize + 1;
+    const double invCount = 1.0 / count;
+    const int lanes = mLanes;
+
+    // 1. Running means; X and Y from the mean-normalised colours (minus their DC of 1)
+    float* slot = mRgb + static_cast<size_t>(mHead) * 3 * lanes;
+    for (int c = 0; c < mChannels; ++c) {
+        float n[3];
+        bool valid = true;
+        for (int k = 0; k < 3; ++k) {
+            float v = rgb[3 * c + k];
+            float* cell = slot + k * lanes + c;
+            double& sum = mRgbSums[k * lanes + c];
+            sum += static_cast<double>(v) - *cell;
+            *cell = v;
+            double mean = sum * invCount;
+            valid = valid && mean > 0.0;
+            n[k] = valid ? static_cast<float>(v / mean) - 1.0f : 0.0f;
+        }
+        mX[c] = valid ? 3.0f * n[0] - 2.0f * n[1] : 0.0f;
+        mY[c] = valid ? 1.5f * n[0] + n[1] - 1.5f * n[2] : 0.0f;
+    }
+
+    // 2. Band-pass X and Y of every lane
+    for (int s = 0; s < 2; ++s) {
+        float* signal = s == 0 ? mX : mY;
+        for (int f = 0; f < 2; ++f) {
+            const Biquad q = mFilters[f];
+            float* s1 = mState + (4 * s + 2 * f) * lanes;
+            float* s2 = s1 + lanes;
+            for (int c = 0; c < lanes; ++c) {
+                float in = signal[c];
+                float out = q.b0 * in + s1[c];
+                s1[c] = q.b1 * in - q.a1 * out + s2[c];
+                s2[c] = q.b2 * in - q.a2 * out;
+                signal[c] = out;
+            }
+        }
+    }
+
+    // 3. Windowed standard deviations of Xf and Yf, and the projection
+    float* filtered = mFiltered + static_cast<size_t>(mHead) * 2 * lanes;
+    double* sumX = mMoments;
+    double* sumXX = mMoments + lanes;
+    double* sumY = mMoments + 2 * lanes;
+    double* sumYY = mMoments + 3 * lanes;
+    for (int c = 0; c < lanes; ++c) {
+        double x = mX[c], y = mY[c];
+        double oldX = filtered[c], oldY = filtered[lanes + c];
+        sumX[c] += x - oldX;
+        sumXX[c] += x * x - oldX * oldX;
+        sumY[c] += y - oldY;
+        sumYY[c] += y * y - oldY * oldY;
+        filtered[c] = mX[c];
+        filtered[lanes + c] = mY[c];
+
+        double meanX = sumX[c] * invCount, meanY = sumY[c] * invCount;
+        double varX = std::max(0.0, sumXX[c] * invCount - meanX * meanX);
+        double varY = std::max(0.0, sumYY[c] * invCount - meanY * meanY);
+        float alpha = varY > 1e-12 ? static_cast<float>(sqrt(varX / varY)) : 0.0f;
+        mAlpha[c] = alpha;
+        mResults[c] = mX[c] - alpha * mY[c];
+    }
+
+    if (++mHead == mWindow) mHead = 0;
+    if (!full) ++mSize;
+    return mResults;
+}
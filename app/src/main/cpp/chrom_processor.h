@@ -0,0 +1,63 @@
+// app/src/main/cpp/chrom_processor.h
+#ifndef OJAS_CHROM_PROCESSOR_H
+#define OJAS_CHROM_PROCESSOR_H
+
+#include "arena.h"
+
+/**
+ * CHROM chrominance pulse extraction (de Haan & Jeanne, 2013) for K ROIs
+ * sampled together, one mean RGB triple per ROI per frame in, one pulse
+ * sample per ROI out. Meant to sit in front of SignalProcessor (or
+ * MultiChannelProcessor) in place of the raw green trace.
+ *
+ * Per frame and ROI, all O(1):
+ *   1. each channel is divided by its running mean over the last window;
+ *   2. X = 3R' - 2G' and Y = 1.5R' + G' - 1.5B';
+ *   3. X and Y are band-passed (Butterworth high-pass + low-pass biquads);
+ *   4. S = Xf - alpha * Yf, alpha = std(Xf) / std(Yf) over the same window.
+ *
+ * State is structure-of-arrays over ROI lanes (padded to a multiple of 4) in
+ * one arena block, so the per-lane loops vectorize.
+ */
+class ChromProcessor {
+public:
+    ChromProcessor(int channels, float samplingRate, float windowSeconds = 1.6f);
+
+    // rgb[3c .. 3c + 2] is ROI c's mean R, G, B for this frame. Returns one
+    // pulse sample per ROI, valid until the next call. A ROI whose running
+    // mean is not positive (no pixels yet) yields 0.
+    const float* process(const float* rgb);
+
+    // Current std(Xf) / std(Yf) of ROI c
+    float alpha(int channel) const { return mAlpha[channel]; }
+
+    int getChannelCount() const { return mChannels; }
+    void reset();
+
+private:
+    // Direct form II transposed, coefficients normalised by a0
+    struct Biquad {
+        float b0, b1, b2, a1, a2;
+    };
+
+    int mChannels;
+    int mLanes;          // channels rounded up to a multiple of 4; extra lanes stay zero
+    int mWindow;         // frames in the normalisation / alpha window
+    Biquad mFilters[2];  // high-pass, then low-pass
+
+    int mHead = 0;
+    int mSize = 0;
+
+    Arena mArena;
+    float* mRgb;         // [slot][channel R/G/B][lane] ring of the window's inputs
+    double* mRgbSums;    // [channel][lane] running sums of mRgb
+    float* mFiltered;    // [slot][Xf/Yf][lane] ring of the window's filtered signals
+    double* mMoments;    // [sum Xf, sum Xf², sum Yf, sum Yf²][lane]
+    float* mState;       // [signal X/Y][filter][s1/s2][lane]
+    float* mX;           // this frame's X, then Xf
+    float* mY;
+    float* mAlpha;
+    float* mResults;
+};
+
+#endif //OJAS_CHROM_PROCESSOR_H
@@ -0,0 +1,75 @@
+// app/src/main/cpp/decimator.cpp
+#include "decimator.h"
+#include <cmath>
+
+#ifdef USE_NEON
+#include <arm_neon.h>
+#elif defined(USE_SSE)
+#include <immintrin.h>
+#endif
+
+static float dot(const float* a, const float* b, int n) {
+    int i = 0;
+    float sum = 0.0f;
+#ifdef USE_NEON
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i <= n - 4; i += 4) {
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    float32x2_t half = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    sum = vget_lane_f32(vpadd_f32(half, half), 0);
+#elif defined(USE_SSE)
+    __m128 acc = _mm_setzero_ps();
+    for (; i <= n - 4; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    __m128 half = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    sum = _mm_cvtss_f32(_mm_add_ss(half, _mm_shuffle_ps(half, half, 1)));
+#endif
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+size_t FirDecimator::arenaBytes(int taps) {
+    return Arena::bytesFor<float>(taps) +
+           Arena::bytesFor<float>(RingBuffer<float>::storageSize(taps));
+}
+
+FirDecimator::FirDecimator(int factor, int taps, Arena& arena)
+        : mFactor(factor > 0 ? factor : 1), mTaps(taps > 0 ? taps : 1) {
+
+    // Windowed sinc, cutoff at 0.8 * output Nyquist, normalised to unity DC gain
+    mCoeffs = arena.allocate<float>(mTaps);
+    const double cutoff = 0.8 * 0.5 / mFactor;   // cycles per input sample
+    const double centre = 0.5 * (mTaps - 1);
+    double sum = 0.0;
+    for (int i = 0; i < mTaps; ++i) {
+        double t = i - centre;
+        double sinc = t == 0.0 ? 2.0 * cutoff : sin(2.0 * M_PI * cutoff * t) / (M_PI * t);
+        double window = mTaps > 1 ? 0.54 - 0.46 * cos(2.0 * M_PI * i / (mTaps - 1)) : 1.0;
+        mCoeffs[i] = static_cast<float>(sinc * window);
+        sum += mCoeffs[i];
+    }
+    for (int i = 0; i < mTaps; ++i) mCoeffs[i] = static_cast<float>(mCoeffs[i] / sum);
+
+    mDelay.reset(new RingBuffer<float>(
+            mTaps, arena.allocate<float>(RingBuffer<float>::storageSize(mTaps))));
+}
+
+bool FirDecimator::push(float value, float* out) {
+    mDelay->push(value);
+    if (++mPhase < mFactor) return false;
+    mPhase = 0;
+
+    // Hold off until the delay line is full rather than filtering a zero-padded step
+    if (!mDelay->full()) return false;
+    *out = dot(mDelay->data(), mCoeffs, mTaps);
+    return true;
+}
+
+void FirDecimator::reset() {
+    mDelay->clear();
+    mPhase = 0;
+}
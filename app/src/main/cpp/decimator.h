@@ -0,0 +1,37 @@
+// app/src/main/cpp/decimator.h
+#ifndef OJAS_DECIMATOR_H
+#define OJAS_DECIMATOR_H
+
+#include <memory>
+#include "arena.h"
+#include "ring_buffer.h"
+
+/**
+ * Low-pass FIR decimator by an integer factor.
+ *
+ * The anti-alias filter is a Hamming-windowed sinc with its cutoff at 0.8 of
+ * the output Nyquist rate. Only every factor-th output is evaluated (the
+ * polyphase shortcut), so each input costs taps / factor multiply-adds.
+ */
+class FirDecimator {
+public:
+    // Coefficients and delay line are carved from `arena`, which must have arenaBytes() free
+    FirDecimator(int factor, int taps, Arena& arena);
+    static size_t arenaBytes(int taps);
+
+    // Returns true and writes *out when an output sample is due
+    bool push(float value, float* out);
+
+    void reset();
+
+    int factor() const { return mFactor; }
+
+private:
+    int mFactor;
+    int mTaps;
+    int mPhase = 0;
+    float* mCoeffs;     // symmetric, so no reversal is needed against the delay line
+    std::unique_ptr<RingBuffer<float>> mDelay;
+};
+
+#endif //OJAS_DECIMATOR_H
@@ -0,0 +1,287 @@
+// app/src/main/cpp/frame_stats.cpp
+#include "frame_stats.h"
+#include "thread_pool.h"
+#include <algorithm>
+
+#ifdef USE_NEON
+#include <arm_neon.h>
+
+// vaddvq_u32 is AArch64-only; this also builds for armeabi-v7a
+static inline uint32_t horizontalSum(uint32x4_t v) {
+    return vgetq_lane_u32(v, 0) + vgetq_lane_u32(v, 1) +
+           vgetq_lane_u32(v, 2) + vgetq_lane_u32(v, 3);
+}
+
+#ifdef __aarch64__
+#include "frame_stats_dotprod.h"
+#include <sys/auxv.h>
+
+#ifndef HWCAP_ASIMDDP
+#define HWCAP_ASIMDDP (1 << 20)
+#endif
+
+// ARMv8.2 dot product (Cortex-A55/A75 and later); older cores keep the widening loops
+static const bool kHasDotProd = (getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0;
+static bool gUseDotProd = kHasDotProd;
+#endif
+#elif defined(USE_SSE)
+#include <immintrin.h>
+
+// SSE4.1 is part of the x86_64 Android ABI; AVX2 is used when the CPU has it
+static const bool kHasAvx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+}();
+static bool gUseAvx2 = kHasAvx2;
+
+static inline uint64_t addLanes64(__m128i v) {
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(v)) +
+           static_cast<uint64_t>(_mm_extract_epi64(v, 1));
+}
+
+static inline uint64_t addLanes32(__m128i v) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm_extract_epi32(v, 0))) +
+           static_cast<uint32_t>(_mm_extract_epi32(v, 1)) +
+           static_cast<uint32_t>(_mm_extract_epi32(v, 2)) +
+           static_cast<uint32_t>(_mm_extract_epi32(v, 3));
+}
+
+// Sums the bytes selected by `mask` (repeated per 32-bit word) for loads starting
+// at pixels i, i + step, ... up to `last`; psadbw adds them into u64 lanes
+static uint64_t sumMaskedSse(const uint8_t* row, int& i, int last, int pixelStride, uint32_t mask) {
+    const int step = 16 / pixelStride;
+    const __m128i vMask = _mm_set1_epi32(static_cast<int>(mask));
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    for (; i <= last; i += step) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i * pixelStride));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_and_si128(v, vMask), zero));
+    }
+    return addLanes64(acc);
+}
+
+__attribute__((target("avx2")))
+static uint64_t sumMaskedAvx2(const uint8_t* row, int& i, int last, int pixelStride, uint32_t mask) {
+    const int step = 32 / pixelStride;
+    const __m256i vMask = _mm256_set1_epi32(static_cast<int>(mask));
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    for (; i <= last; i += step) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i * pixelStride));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_and_si256(v, vMask), zero));
+    }
+    return addLanes64(_mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+}
+
+// RGBA sums and squares: each channel is shifted down to the low byte of its
+// 32-bit word, so pmaddwd squares it exactly; u32 lanes are flushed to u64
+// every 4096 loads so the squares cannot overflow
+static void accumulateRgbaSse(const uint8_t* row, int& i, int count,
+                              uint64_t sums[3], uint64_t squares[3]) {
+    const __m128i low = _mm_set1_epi32(0xFF);
+    while (i <= count - 4) {
+        __m128i acc[3], accSq[3];
+        for (int c = 0; c < 3; ++c) acc[c] = accSq[c] = _mm_setzero_si128();
+        int blockEnd = std::min(count - 4, i + 4 * 4095);
+        for (; i <= blockEnd; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i * 4));
+            for (int c = 0; c < 3; ++c) {
+                __m128i x = _mm_and_si128(_mm_srli_epi32(v, 8 * c), low);
+                acc[c] = _mm_add_epi32(acc[c], x);
+                accSq[c] = _mm_add_epi32(accSq[c], _mm_madd_epi16(x, x));
+            }
+        }
+        for (int c = 0; c < 3; ++c) {
+            sums[c] += addLanes32(acc[c]);
+            squares[c] += addLanes32(accSq[c]);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static void accumulateRgbaAvx2(const uint8_t* row, int& i, int count,
+                               uint64_t sums[3], uint64_t squares[3]) {
+    const __m256i low = _mm256_set1_epi32(0xFF);
+    while (i <= count - 8) {
+        __m256i acc[3], accSq[3];
+        for (int c = 0; c < 3; ++c) acc[c] = accSq[c] = _mm256_setzero_si256();
+        int blockEnd = std::min(count - 8, i + 8 * 4095);
+        for (; i <= blockEnd; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i * 4));
+            for (int c = 0; c < 3; ++c) {
+                __m256i x = _mm256_and_si256(_mm256_srli_epi32(v, 8 * c), low);
+                acc[c] = _mm256_add_epi32(acc[c], x);
+                accSq[c] = _mm256_add_epi32(accSq[c], _mm256_madd_epi16(x, x));
+            }
+        }
+        for (int c = 0; c < 3; ++c) {
+            sums[c] += addLanes32(_mm256_castsi256_si128(acc[c])) +
+                       addLanes32(_mm256_extracti128_si256(acc[c], 1));
+            squares[c] += addLanes32(_mm256_castsi256_si128(accSq[c])) +
+                          addLanes32(_mm256_extracti128_si256(accSq[c], 1));
+        }
+    }
+}
+#endif
+
+bool dotProdEnabled() {
+#if defined(USE_NEON) && defined(__aarch64__)
+    return gUseDotProd;
+#else
+    return false;
+#endif
+}
+
+void setDotProdEnabled(bool enabled) {
+#if defined(USE_NEON) && defined(__aarch64__)
+    gUseDotProd = enabled && kHasDotProd;
+#else
+    (void) enabled;
+#endif
+}
+
+bool avx2Enabled() {
+#ifdef USE_SSE
+    return gUseAvx2;
+#else
+    return false;
+#endif
+}
+
+void setAvx2Enabled(bool enabled) {
+#ifdef USE_SSE
+    gUseAvx2 = enabled && kHasAvx2;
+#else
+    (void) enabled;
+#endif
+}
+
+bool planeFits(const PlaneView& plane, int pixelBytes) {
+    if (!plane.data || plane.width <= 0 || plane.height <= 0 ||
+        plane.rowStride <= 0 || plane.pixelStride <= 0) {
+        return false;
+    }
+    // The last row only needs to reach its last pixel, not a full stride
+    size_t last = static_cast<size_t>(plane.height - 1) * plane.rowStride +
+                  static_cast<size_t>(plane.width - 1) * plane.pixelStride + pixelBytes;
+    return last <= plane.size;
+}
+
+uint32_t sumChannelSpan(const uint8_t* row, int count, int pixelStride, int channel) {
+    uint32_t sum = 0;
+    int i = 0;
+#ifdef USE_NEON
+#ifdef __aarch64__
+    // Same loads and bounds as below, which then find nothing left to do
+    if (gUseDotProd) sum = sumChannelDot(row, i, count, pixelStride, channel);
+#endif
+    // Interleaved loads read whole pixels, so the last pixel is left to the scalar tail
+    uint32x4_t acc = vdupq_n_u32(0);
+    if (pixelStride == 4) {
+        // RGBA: de-interleave 16 pixels per load
+        for (; i < count - 16; i += 16) {
+            uint8x16x4_t block = vld4q_u8(row + i * 4);
+            uint8x16_t bytes = channel == 0 ? block.val[0] : channel == 1 ? block.val[1]
+                             : channel == 2 ? block.val[2] : block.val[3];
+            acc = vpadalq_u16(acc, vpaddlq_u8(bytes));
+        }
+    } else if (pixelStride == 2) {
+        // Semi-planar chroma (U and V interleaved)
+        for (; i < count - 16; i += 16) {
+            uint8x16x2_t block = vld2q_u8(row + i * 2);
+            uint8x16_t bytes = channel == 0 ? block.val[0] : block.val[1];
+            acc = vpadalq_u16(acc, vpaddlq_u8(bytes));
+        }
+    } else if (pixelStride == 1) {
+        // Packed plane (Y, or U/V without interleave)
+        for (; i <= count - 16; i += 16) {
+            acc = vpadalq_u16(acc, vpaddlq_u8(vld1q_u8(row + i)));
+        }
+    }
+    sum += horizontalSum(acc);
+#elif defined(USE_SSE)
+    if (pixelStride == 4 || pixelStride == 2 || pixelStride == 1) {
+        // Byte mask selecting the channel in every 32-bit word
+        uint32_t mask = pixelStride == 4 ? 0xFFu << (8 * channel)
+                      : pixelStride == 2 ? 0x00FF00FFu << (8 * channel) : 0xFFFFFFFFu;
+        // As above, interleaved loads leave the last pixel to the scalar tail
+        int tail = pixelStride == 1 ? 0 : 1;
+        if (gUseAvx2) {
+            sum += static_cast<uint32_t>(
+                    sumMaskedAvx2(row, i, count - 32 / pixelStride - tail, pixelStride, mask));
+        }
+        sum += static_cast<uint32_t>(
+                sumMaskedSse(row, i, count - 16 / pixelStride - tail, pixelStride, mask));
+    }
+#endif
+    const uint8_t* p = row + static_cast<size_t>(i) * pixelStride + channel;
+    for (; i < count; ++i, p += pixelStride) {
+        sum += *p;
+    }
+    return sum;
+}
+
+void accumulateRgbaSpan(const uint8_t* row, int count, uint64_t sums[3], uint64_t squares[3]) {
+    int i = 0;
+#ifdef USE_NEON
+#ifdef __aarch64__
+    if (gUseDotProd) accumulateRgbaDot(row, i, count, sums, squares);
+#endif
+    // Widening chain: u8 -> u16 (pairwise sums, squares) -> u32 lanes, flushed to
+    // u64 every 4096 pixels so the square lanes cannot overflow
+    while (i <= count - 16) {
+        uint32x4_t acc[3], accSq[3];
+        for (int c = 0; c < 3; ++c) acc[c] = accSq[c] = vdupq_n_u32(0);
+        int blockEnd = std::min(count - 16, i + 4096);
+        for (; i <= blockEnd; i += 16) {
+            uint8x16x4_t block = vld4q_u8(row + i * 4);
+            for (int c = 0; c < 3; ++c) {
+                uint8x16_t v = block.val[c];
+                acc[c] = vpadalq_u16(acc[c], vpaddlq_u8(v));
+                accSq[c] = vpadalq_u16(accSq[c], vmull_u8(vget_low_u8(v), vget_low_u8(v)));
+                accSq[c] = vpadalq_u16(accSq[c], vmull_u8(vget_high_u8(v), vget_high_u8(v)));
+            }
+        }
+        for (int c = 0; c < 3; ++c) {
+            sums[c] += horizontalSum(acc[c]);
+            squares[c] += horizontalSum(accSq[c]);
+        }
+    }
+#elif defined(USE_SSE)
+    if (gUseAvx2) accumulateRgbaAvx2(row, i, count, sums, squares);
+    accumulateRgbaSse(row, i, count, sums, squares);
+#endif
+    for (const uint8_t* p = row + i * 4; i < count; ++i, p += 4) {
+        for (int c = 0; c < 3; ++c) {
+            uint32_t v = p[c];
+            sums[c] += v;
+            squares[c] += v * v;
+        }
+    }
+}
+
+float averageChannel(const PlaneView& plane, int channel, int left, int top, int width, int height,
+                     ThreadPool* pool) {
+    int x0 = std::max(0, left);
+    int y0 = std::max(0, top);
+    int x1 = std::min(plane.width, left + width);
+    int y1 = std::min(plane.height, top + height);
+    if (x1 <= x0 || y1 <= y0 || channel < 0 || channel >= plane.pixelStride) return 0.0f;
+
+    // A row sum fits 32 bits for any realistic width; a tile's total may not
+    uint64_t partial[kMaxRowTiles] = {};
+    const int tiles = rowTileCount(pool, y1 - y0, x1 - x0);
+    forEachRowTile(pool, tiles, y0, y1, [&](int tile, int first, int last) {
+        uint64_t total = 0;
+        const uint8_t* row = plane.data + static_cast<size_t>(first) * plane.rowStride +
+                             static_cast<size_t>(x0) * plane.pixelStride;
+        for (int y = first; y < last; ++y, row += plane.rowStride) {
+            total += sumChannelSpan(row, x1 - x0, plane.pixelStride, channel);
+        }
+        partial[tile] = total;
+    });
+
+    uint64_t total = 0;
+    for (int t = 0; t < tiles; ++t) total += partial[t];
+    return static_cast<float>(total) / (static_cast<float>(x1 - x0) * (y1 - y0));
+}
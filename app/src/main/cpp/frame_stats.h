@@ -0,0 +1,62 @@
+// app/src/main/cpp/frame_stats.h
+#ifndef OJAS_FRAME_STATS_H
+#define OJAS_FRAME_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+class ThreadPool;
+
+/**
+ * Strided view of one 8-bit image plane, e.g. an ImageProxy plane's direct
+ * ByteBuffer. Pixel (x, y) starts at data + y * rowStride + x * pixelStride.
+ */
+struct PlaneView {
+    const uint8_t* data;
+    size_t size;        // bytes addressable from data
+    int width;
+    int height;
+    int rowStride;
+    int pixelStride;
+};
+
+// True when the first pixelBytes bytes of every pixel lie inside size bytes.
+// Interleaved chroma planes only guarantee 1; RGBA buffers hold whole pixels.
+bool planeFits(const PlaneView& plane, int pixelBytes = 1);
+
+/**
+ * Sum of byte `channel` over `count` pixels starting at row, reading no
+ * further than that byte of the last pixel.
+ */
+uint32_t sumChannelSpan(const uint8_t* row, int count, int pixelStride, int channel);
+
+/**
+ * Mean of byte `channel` (0 .. pixelStride - 1) over the rectangle
+ * [left, left + width) x [top, top + height), clipped to the plane.
+ * Reads only the pixels inside the rectangle; returns 0 if it is empty.
+ * Large rectangles are split into row tiles across `pool` when one is given.
+ */
+float averageChannel(const PlaneView& plane, int channel, int left, int top, int width, int height,
+                     ThreadPool* pool = nullptr);
+
+/**
+ * Adds the R, G and B bytes of `count` consecutive RGBA pixels starting at
+ * row into sums[0..2], and their squares into squares[0..2], in one pass.
+ */
+void accumulateRgbaSpan(const uint8_t* row, int count, uint64_t sums[3], uint64_t squares[3]);
+
+/**
+ * Whether the span kernels here and in roi_extractor take the ARMv8.2
+ * dot-product (UDOT) path. It is on by default wherever the CPU reports the
+ * extension and can never be turned on elsewhere; tests switch it off to
+ * compare the UDOT results with the widening loops. Not thread-safe against
+ * kernels running at the same time.
+ */
+bool dotProdEnabled();
+void setDotProdEnabled(bool enabled);
+
+// The same for the AVX2 span loops on x86_64: off, the SSE4.1 baseline runs
+bool avx2Enabled();
+void setAvx2Enabled(bool enabled);
+
+#endif //OJAS_FRAME_STATS_H
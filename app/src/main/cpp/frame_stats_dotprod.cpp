@@ -0,0 +1,121 @@
+// app/src/main/cpp/frame_stats_dotprod.cpp
+#include "frame_stats_dotprod.h"
+#include "roi_extractor.h"
+
+#if defined(USE_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+
+// UDOT against a vector of ones adds four bytes into each u32 lane in one
+// instruction, replacing the u8 -> u16 -> u32 widening pair. Keep this file
+// free of library templates: everything here is compiled for ARMv8.2.
+
+uint32_t sumChannelDot(const uint8_t* row, int& i, int count, int pixelStride, int channel) {
+    const uint8x16_t ones = vdupq_n_u8(1);
+    // u32 lanes wrap modulo 2^32 just like the scalar sum
+    uint32x4_t acc = vdupq_n_u32(0);
+    if (pixelStride == 4) {
+        for (; i < count - 16; i += 16) {
+            uint8x16x4_t block = vld4q_u8(row + i * 4);
+            uint8x16_t bytes = channel == 0 ? block.val[0] : channel == 1 ? block.val[1]
+                             : channel == 2 ? block.val[2] : block.val[3];
+            acc = vdotq_u32(acc, bytes, ones);
+        }
+    } else if (pixelStride == 2) {
+        for (; i < count - 16; i += 16) {
+            uint8x16x2_t block = vld2q_u8(row + i * 2);
+            acc = vdotq_u32(acc, channel == 0 ? block.val[0] : block.val[1], ones);
+        }
+    } else if (pixelStride == 1) {
+        uint32x4_t acc2 = acc;
+        for (; i <= count - 32; i += 32) {
+            acc = vdotq_u32(acc, vld1q_u8(row + i), ones);
+            acc2 = vdotq_u32(acc2, vld1q_u8(row + i + 16), ones);
+        }
+        for (; i <= count - 16; i += 16) {
+            acc = vdotq_u32(acc, vld1q_u8(row + i), ones);
+        }
+        acc = vaddq_u32(acc, acc2);
+    }
+    return vaddvq_u32(acc);
+}
+
+void accumulateRgbaDot(const uint8_t* row, int& i, int count, uint64_t sums[3], uint64_t squares[3]) {
+    const uint8x16_t ones = vdupq_n_u8(1);
+    // UDOT of a channel with itself adds four squares (<= 260100) per lane, so
+    // lanes are flushed to u64 every 4096 loads
+    while (i <= count - 16) {
+        uint32x4_t acc[3], accSq[3];
+        for (int c = 0; c < 3; ++c) acc[c] = accSq[c] = vdupq_n_u32(0);
+        int blockEnd = i + 16 * 4095 < count - 16 ? i + 16 * 4095 : count - 16;
+        for (; i <= blockEnd; i += 16) {
+            uint8x16x4_t block = vld4q_u8(row + i * 4);
+            for (int c = 0; c < 3; ++c) {
+                acc[c] = vdotq_u32(acc[c], block.val[c], ones);
+                accSq[c] = vdotq_u32(accSq[c], block.val[c], block.val[c]);
+            }
+        }
+        for (int c = 0; c < 3; ++c) {
+            sums[c] += vaddlvq_u32(acc[c]);
+            squares[c] += vaddlvq_u32(accSq[c]);
+        }
+    }
+}
+
+// Same loads, bounds and mask as the widening loop in accumulateYuvSpan. A
+// byte product dotted in place replaces each vmull_u8/vpadalq_u16 pair, and
+// sums dot with ones. Products of one 16-pixel step add at most 260100 per
+// lane, so the u32 lanes hold any row a camera delivers.
+template <bool kSkinOnly>
+static int accumulateYuv(const uint8_t* yRow, const uint8_t* uRow, const uint8_t* vRow, int uvStep,
+                         int& x, int limit, const SkinThresholds& skin, uint32_t moments[9]) {
+    const uint8x16_t ones = vdupq_n_u8(1);
+    const uint8x16_t minY = vdupq_n_u8(skin.minY), maxY = vdupq_n_u8(skin.maxY);
+    const uint8x8_t minCb = vdup_n_u8(skin.minCb), maxCb = vdup_n_u8(skin.maxCb);
+    const uint8x8_t minCr = vdup_n_u8(skin.minCr), maxCr = vdup_n_u8(skin.maxCr);
+    const uint8x8_t minChroma = vdup_n_u8(skin.minCrMinusCb);
+    uint32x4_t acc[9], accN = vdupq_n_u32(0);
+    for (int k = 0; k < 9; ++k) acc[k] = accN;
+    const int start = x;
+    for (; x <= limit; x += 16) {
+        uint8x16_t l = vld1q_u8(yRow + x);
+        uint8x8_t u = uvStep == 2 ? vld2_u8(uRow + x).val[0] : vld1_u8(uRow + (x >> 1));
+        uint8x8_t v = uvStep == 2 ? vld2_u8(vRow + x).val[0] : vld1_u8(vRow + (x >> 1));
+
+        uint8x8x2_t uPairs = vzip_u8(u, u);
+        uint8x8x2_t vPairs = vzip_u8(v, v);
+        uint8x16_t lm = l;
+        uint8x16_t um = vcombine_u8(uPairs.val[0], uPairs.val[1]);
+        uint8x16_t vm = vcombine_u8(vPairs.val[0], vPairs.val[1]);
+        if constexpr (kSkinOnly) {
+            uint8x8_t chroma = vand_u8(vand_u8(vcge_u8(u, minCb), vcle_u8(u, maxCb)),
+                                       vand_u8(vcge_u8(v, minCr), vcle_u8(v, maxCr)));
+            chroma = vand_u8(chroma, vcge_u8(vqsub_u8(v, u), minChroma));
+            uint8x8x2_t wide = vzip_u8(chroma, chroma);
+            uint8x16_t mask = vandq_u8(vcombine_u8(wide.val[0], wide.val[1]),
+                                       vandq_u8(vcgeq_u8(l, minY), vcleq_u8(l, maxY)));
+            lm = vandq_u8(lm, mask);
+            um = vandq_u8(um, mask);
+            vm = vandq_u8(vm, mask);
+            accN = vdotq_u32(accN, vandq_u8(mask, ones), ones);
+        }
+
+        acc[0] = vdotq_u32(acc[0], lm, ones);
+        acc[1] = vdotq_u32(acc[1], um, ones);
+        acc[2] = vdotq_u32(acc[2], vm, ones);
+        acc[3] = vdotq_u32(acc[3], lm, lm);
+        acc[4] = vdotq_u32(acc[4], um, um);
+        acc[5] = vdotq_u32(acc[5], vm, vm);
+        acc[6] = vdotq_u32(acc[6], lm, um);
+        acc[7] = vdotq_u32(acc[7], lm, vm);
+        acc[8] = vdotq_u32(acc[8], um, vm);
+    }
+    for (int k = 0; k < 9; ++k) moments[k] += vaddvq_u32(acc[k]);
+    return kSkinOnly ? static_cast<int>(vaddvq_u32(accN)) : x - start;
+}
+
+int accumulateYuvDot(const uint8_t* yRow, const uint8_t* uRow, const uint8_t* vRow, int uvStep,
+                     int& x, int limit, const SkinThresholds* skin, uint32_t moments[9]) {
+    if (skin) return accumulateYuv<true>(yRow, uRow, vRow, uvStep, x, limit, *skin, moments);
+    return accumulateYuv<false>(yRow, uRow, vRow, uvStep, x, limit, SkinThresholds(), moments);
+}
+#endif
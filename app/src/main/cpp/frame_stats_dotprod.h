@@ -0,0 +1,31 @@
+// app/src/main/cpp/frame_stats_dotprod.h
+#ifndef OJAS_FRAME_STATS_DOTPROD_H
+#define OJAS_FRAME_STATS_DOTPROD_H
+
+#include <cstdint>
+
+struct SkinThresholds;
+
+#if defined(USE_NEON) && defined(__aarch64__)
+/**
+ * ARMv8.2 dot-product (UDOT) versions of the frame_stats span loops. Their
+ * translation unit is built with +dotprod, so only call them when HWCAP
+ * reports ASIMDDP. Each starts at pixel i and leaves i at the first pixel it
+ * did not consume; the caller finishes the span.
+ */
+uint32_t sumChannelDot(const uint8_t* row, int& i, int count, int pixelStride, int channel);
+
+void accumulateRgbaDot(const uint8_t* row, int& i, int count, uint64_t sums[3], uint64_t squares[3]);
+
+/**
+ * Moments of one luma row for roi_extractor, 16 pixels per step from luma
+ * column x while x <= limit (packed luma, chroma with pixel stride uvStep of
+ * 1 or 2). Adds Y, Cb, Cr and their products to moments[] in the order y, u,
+ * v, yy, uu, vv, yu, yv, uv; with skin, only the pixels inside it, and
+ * returns how many pixels were added.
+ */
+int accumulateYuvDot(const uint8_t* yRow, const uint8_t* uRow, const uint8_t* vRow, int uvStep,
+                     int& x, int limit, const SkinThresholds* skin, uint32_t moments[9]);
+#endif
+
+#endif //OJAS_FRAME_STATS_DOTPROD_H
@@ -0,0 +1,94 @@
+#include "kiss_fftr.h"
+
+#ifndef M_PI
+#define M_PI 3.141592653589793238462643383279502884197169399375105820974944
+#endif
+
+struct kiss_fftr_state {
+    int ncfft;
+    kiss_fft_cfg substate;
+    kiss_fft_cpx *tmpbuf;
+    kiss_fft_cpx *super_twiddles;
+};
+
+kiss_fftr_cfg kiss_fftr_alloc(int nfft, int inverse_fft, void * mem, size_t * lenmem) {
+    kiss_fftr_cfg st = NULL;
+    size_t subsize = 0, memneeded;
+
+    if (nfft & 1) {
+        return NULL;
+    }
+    int ncfft = nfft >> 1;
+
+    kiss_fft_alloc(ncfft, inverse_fft, NULL, &subsize);
+    memneeded = sizeof(struct kiss_fftr_state) + subsize + sizeof(kiss_fft_cpx) * (ncfft * 3 / 2);
+
+    if (lenmem == NULL) {
+        st = (kiss_fftr_cfg)KISS_FFT_MALLOC(memneeded);
+    } else {
+        if (*lenmem >= memneeded)
+            st = (kiss_fftr_cfg)mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    // Layout: [state][complex sub-FFT][tmpbuf: ncfft][super twiddles: ncfft/2]
+    st->ncfft = ncfft;
+    st->substate = (kiss_fft_cfg)(st + 1);
+    st->tmpbuf = (kiss_fft_cpx*)(((char*)st->substate) + subsize);
+    st->super_twiddles = st->tmpbuf + ncfft;
+    kiss_fft_alloc(ncfft, inverse_fft, st->substate, &subsize);
+
+    for (int i = 0; i < ncfft / 2; ++i) {
+        double phase = -M_PI * ((double)(i + 1) / ncfft + .5);
+        if (inverse_fft)
+            phase *= -1;
+        st->super_twiddles[i].r = (float)cos(phase);
+        st->super_twiddles[i].i = (float)sin(phase);
+    }
+    return st;
+}
+
+void kiss_fftr(kiss_fftr_cfg st, const float *timedata, kiss_fft_cpx *freqdata) {
+    const int ncfft = st->ncfft;
+    kiss_fft_cpx tdc;
+
+    // Even/odd samples are packed as the real/imaginary parts of one
+    // half-length complex sequence
+    kiss_fft(st->substate, (const kiss_fft_cpx*)timedata, st->tmpbuf);
+
+    tdc = st->tmpbuf[0];
+    freqdata[0].r = tdc.r + tdc.i;
+    freqdata[0].i = 0;
+    freqdata[ncfft].r = tdc.r - tdc.i;
+    freqdata[ncfft].i = 0;
+
+    // Split the packed spectrum back into the real-input spectrum
+    for (int k = 1; k <= ncfft / 2; ++k) {
+        kiss_fft_cpx fpk, fpnk, f1k, f2k, tw;
+
+        fpk = st->tmpbuf[k];
+        fpnk.r = st->tmpbuf[ncfft - k].r;
+        fpnk.i = -st->tmpbuf[ncfft - k].i;
+
+        f1k.r = fpk.r + fpnk.r;
+        f1k.i = fpk.i + fpnk.i;
+        f2k.r = fpk.r - fpnk.r;
+        f2k.i = fpk.i - fpnk.i;
+
+        tw.r = f2k.r * st->super_twiddles[k - 1].r - f2k.i * st->super_twiddles[k - 1].i;
+        tw.i = f2k.r * st->super_twiddles[k - 1].i + f2k.i * st->super_twiddles[k - 1].r;
+
+        freqdata[k].r = 0.5f * (f1k.r + tw.r);
+        freqdata[k].i = 0.5f * (f1k.i + tw.i);
+        freqdata[ncfft - k].r = 0.5f * (f1k.r - tw.r);
+        freqdata[ncfft - k].i = 0.5f * (tw.i - f1k.i);
+    }
+}
+
+void kiss_fftr_free(kiss_fftr_cfg cfg) {
+    if (cfg) {
+        KISS_FFT_FREE(cfg);
+    }
+}
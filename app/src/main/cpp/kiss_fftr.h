@@ -0,0 +1,23 @@
+#ifndef KISS_FFTR_H
+#define KISS_FFTR_H
+
+#include "kiss_fft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Real-input FFT: nfft real samples in, nfft/2 + 1 complex bins out.
+// nfft must be even; the transform runs as one nfft/2 complex FFT plus a
+// split (twiddle) pass.
+typedef struct kiss_fftr_state* kiss_fftr_cfg;
+
+kiss_fftr_cfg kiss_fftr_alloc(int nfft, int inverse_fft, void * mem, size_t * lenmem);
+void kiss_fftr(kiss_fftr_cfg cfg, const float *timedata, kiss_fft_cpx *freqdata);
+void kiss_fftr_free(kiss_fftr_cfg cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,306 @@
+// app/src/main/cpp/multi_channel_processor.cpp
+#include "multi_channel_processor.h"
+#include "ring_buffer.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef USE_NEON
+#include <arm_neon.h>
+#elif defined(USE_SSE)
+#include <immintrin.h>
+#endif
+
+// Valid heart-rate band (45 - 200 BPM), as in SignalProcessor
+static constexpr float kMinHrHz = 0.75f;
+static constexpr float kMaxHrHz = 3.33f;
+
+static int roundUp4(int n) {
+    return (n + 3) & ~3;
+}
+
+MultiChannelProcessor::MultiChannelProcessor(int channels, int bufferSize, float samplingRate)
+        : mChannels(std::max(1, channels)), mBufferSize(std::max(2, bufferSize)),
+          mSamplingRate(samplingRate) {
+    mLanes = roundUp4(mChannels);
+    mPaddedLength = roundUp4(mBufferSize);
+    mStride = Arena::bytesFor<float>(2 * static_cast<size_t>(mBufferSize)) / sizeof(float);
+
+    int first = static_cast<int>(ceilf(kMinHrHz * mBufferSize / mSamplingRate));
+    int last = static_cast<int>(floorf(kMaxHrHz * mBufferSize / mSamplingRate));
+    mFirstBin = std::max(0, first - 1);
+    mBinCount = std::min(mBufferSize / 2, last + 1) - mFirstBin + 1;
+    const int minLength = std::min(mBufferSize, static_cast<int>(ceilf(mSamplingRate * 3)));
+
+    mArena.reset(Arena::bytesFor<float>(mStride * mLanes) +
+                 Arena::bytesFor<double>(mLanes) +
+                 Arena::bytesFor<float>(static_cast<size_t>(mPaddedLength) * mLanes) +
+                 2 * Arena::bytesFor<float>(static_cast<size_t>(mPaddedLength) * mBinCount) +
+                 Arena::bytesFor<float>(static_cast<size_t>(mBinCount) * mLanes) +
+                 8 * Arena::bytesFor<float>(mLanes) +
+                 3 * Arena::bytesFor<int>(mLanes) +
+                 WindowTables::arenaBytes(minLength, mBufferSize));
+
+    mSamples = mArena.allocate<float>(mStride * mLanes);
+    mSums = mArena.allocate<double>(mLanes);
+    mWindowed = mArena.allocate<float>(static_cast<size_t>(mPaddedLength) * mLanes);
+    mCos = mArena.allocate<float>(static_cast<size_t>(mPaddedLength) * mBinCount);
+    mSin = mArena.allocate<float>(static_cast<size_t>(mPaddedLength) * mBinCount);
+    mMagnitude = mArena.allocate<float>(static_cast<size_t>(mBinCount) * mLanes);
+    mPrevHR = mArena.allocate<float>(mLanes);
+    mResults = mArena.allocate<float>(mLanes);
+    mBest = mArena.allocate<float>(mLanes);
+    mBandSum = mArena.allocate<float>(mLanes);
+    mBandPower = mArena.allocate<float>(mLanes);
+    mPeakFraction = mArena.allocate<float>(mLanes);
+    mSnr = mArena.allocate<float>(mLanes);
+    mPeak = mArena.allocate<int>(mLanes);
+    mLo = mArena.allocate<int>(mLanes);
+    mHi = mArena.allocate<int>(mLanes);
+    mWindows.reset(new WindowTables(minLength, mBufferSize, mArena));
+    mWindows->fill(WindowType::Hamming);
+
+    // The basis is evaluated on the full-window grid, so a partial window
+    // is simply zero-padded to the buffer size (as the batch FFT does)
+    for (int b = 0; b < mBinCount; ++b) {
+        int k = mFirstBin + b;
+        for (int t = 0; t < mPaddedLength; ++t) {
+            double phase = 2.0 * M_PI * ((static_cast<long>(k) * t) % mBufferSize) / mBufferSize;
+            mCos[static_cast<size_t>(b) * mPaddedLength + t] = static_cast<float>(cos(phase));
+            mSin[static_cast<size_t>(b) * mPaddedLength + t] = static_cast<float>(sin(phase));
+        }
+    }
+
+    std::fill(mSamples, mSamples + mStride * mLanes, 0.0f);
+    reset();
+}
+
+void MultiChannelProcessor::reset() {
+    mHead = 0;
+    mSize = 0;
+    std::fill(mSums, mSums + mLanes, 0.0);
+    std::fill(mPrevHR, mPrevHR + mLanes, 0.0f);
+    std::fill(mResults, mResults + mLanes, 0.0f);
+    std::fill(mPeakFraction, mPeakFraction + mLanes, 0.0f);
+    std::fill(mSnr, mSnr + mLanes, 0.0f);
+}
+
+void MultiChannelProcessor::addFrame(const float* values) {
+    // Same mirrored layout as RingBuffer, with the head shared by every channel
+    const bool full = mSize == mBufferSize;
+    for (int c = 0; c < mChannels; ++c) {
+        float* ring = mSamples + c * mStride;
+        float oldest = full ? ring[mHead] : 0.0f;
+        mSums[c] += static_cast<double>(values[c]) - oldest;
+        ring[mHead] = values[c];
+        ring[mHead + mBufferSize] = values[c];
+    }
+    if (++mHead == mBufferSize) mHead = 0;
+    if (!full) ++mSize;
+}
+
+void MultiChannelProcessor::setWindow(const float* samples, size_t stride, int n) {
+    n = std::max(0, std::min(n, mBufferSize));
+    for (int c = 0; c < mChannels; ++c) {
+        float* ring = mSamples + c * mStride;
+        const float* in = samples + c * stride;
+        double sum = 0.0;
+        for (int i = 0; i < n; ++i) {
+            ring[i] = in[i];
+            ring[i + mBufferSize] = in[i];
+            sum += in[i];
+        }
+        mSums[c] = sum;
+    }
+    // Oldest sample at ring[0] (full window) or at its mirror ring[mBufferSize]
+    mHead = n % mBufferSize;
+    mSize = n;
+}
+
+const float* MultiChannelProcessor::computeHeartRates() {
+    int n = mSize;
+    if (n < mSamplingRate * 3) {
+        std::fill(mResults, mResults + mLanes, 0.0f);
+        std::fill(mPeakFraction, mPeakFraction + mLanes, 0.0f);
+        std::fill(mSnr, mSnr + mLanes, 0.0f);
+        return mResults;
+    }
+    // While the window fills, analyse the newest samples a window table fits
+    computeMagnitudes(mWindows->length(n));
+    trackPeaks();
+    return mResults;
+}
+
+void MultiChannelProcessor::computeMagnitudes(int n) {
+    // 1. Mean-removed, Hamming-windowed copy of every channel, zero-padded to a multiple of 4
+    const int padded = roundUp4(n);
+    const float* window = mWindows->get(n);
+    for (int c = 0; c < mLanes; ++c) {
+        float* out = mWindowed + static_cast<size_t>(c) * mPaddedLength;
+        if (c < mChannels) {
+            const float* ring = mSamples + c * mStride + mHead + mBufferSize - n;
+            double sum = mSums[c];
+            if (n < mSize) {
+                sum = 0.0;
+                for (int i = 0; i < n; ++i) sum += ring[i];
+            }
+            removeMeanAndWindow(ring, window, static_cast<float>(sum / n), n, out);
+            std::fill(out + n, out + padded, 0.0f);
+        } else {
+            std::fill(out, out + padded, 0.0f);
+        }
+    }
+
+    // 2. Band bins for four channels per pass, so each basis row is loaded once per block
+    for (int c = 0; c < mLanes; c += 4) {
+        const float* x0 = mWindowed + static_cast<size_t>(c) * mPaddedLength;
+        const float* x1 = x0 + mPaddedLength;
+        const float* x2 = x1 + mPaddedLength;
+        const float* x3 = x2 + mPaddedLength;
+        for (int b = 0; b < mBinCount; ++b) {
+            const float* cosRow = mCos + static_cast<size_t>(b) * mPaddedLength;
+            const float* sinRow = mSin + static_cast<size_t>(b) * mPaddedLength;
+            float re[4], im[4];
+#ifdef USE_NEON
+            float32x4_t r0 = vdupq_n_f32(0.0f), r1 = r0, r2 = r0, r3 = r0;
+            float32x4_t i0 = r0, i1 = r0, i2 = r0, i3 = r0;
+            for (int t = 0; t < padded; t += 4) {
+                float32x4_t vc = vld1q_f32(cosRow + t);
+                float32x4_t vs = vld1q_f32(sinRow + t);
+                float32x4_t v0 = vld1q_f32(x0 + t), v1 = vld1q_f32(x1 + t);
+                float32x4_t v2 = vld1q_f32(x2 + t), v3 = vld1q_f32(x3 + t);
+                r0 = vmlaq_f32(r0, v0, vc); i0 = vmlaq_f32(i0, v0, vs);
+                r1 = vmlaq_f32(r1, v1, vc); i1 = vmlaq_f32(i1, v1, vs);
+                r2 = vmlaq_f32(r2, v2, vc); i2 = vmlaq_f32(i2, v2, vs);
+                r3 = vmlaq_f32(r3, v3, vc); i3 = vmlaq_f32(i3, v3, vs);
+            }
+            // Horizontal sums of the four accumulators into one vector
+            float32x4_t reSum = vcombine_f32(
+                    vpadd_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)),
+                              vadd_f32(vget_low_f32(r1), vget_high_f32(r1))),
+                    vpadd_f32(vadd_f32(vget_low_f32(r2), vget_high_f32(r2)),
+                              vadd_f32(vget_low_f32(r3), vget_high_f32(r3))));
+            float32x4_t imSum = vcombine_f32(
+                    vpadd_f32(vadd_f32(vget_low_f32(i0), vget_high_f32(i0)),
+                              vadd_f32(vget_low_f32(i1), vget_high_f32(i1))),
+                    vpadd_f32(vadd_f32(vget_low_f32(i2), vget_high_f32(i2)),
+                              vadd_f32(vget_low_f32(i3), vget_high_f32(i3))));
+            vst1q_f32(re, reSum);
+            vst1q_f32(im, imSum);
+#elif defined(USE_SSE)
+            __m128 r0 = _mm_setzero_ps(), r1 = r0, r2 = r0, r3 = r0;
+            __m128 i0 = r0, i1 = r0, i2 = r0, i3 = r0;
+            for (int t = 0; t < padded; t += 4) {
+                __m128 vc = _mm_loadu_ps(cosRow + t);
+                __m128 vs = _mm_loadu_ps(sinRow + t);
+                __m128 v0 = _mm_loadu_ps(x0 + t), v1 = _mm_loadu_ps(x1 + t);
+                __m128 v2 = _mm_loadu_ps(x2 + t), v3 = _mm_loadu_ps(x3 + t);
+                r0 = _mm_add_ps(r0, _mm_mul_ps(v0, vc)); i0 = _mm_add_ps(i0, _mm_mul_ps(v0, vs));
+                r1 = _mm_add_ps(r1, _mm_mul_ps(v1, vc)); i1 = _mm_add_ps(i1, _mm_mul_ps(v1, vs));
+                r2 = _mm_add_ps(r2, _mm_mul_ps(v2, vc)); i2 = _mm_add_ps(i2, _mm_mul_ps(v2, vs));
+                r3 = _mm_add_ps(r3, _mm_mul_ps(v3, vc)); i3 = _mm_add_ps(i3, _mm_mul_ps(v3, vs));
+            }
+            // haddps pairs give the four horizontal sums in lane order
+            _mm_storeu_ps(re, _mm_hadd_ps(_mm_hadd_ps(r0, r1), _mm_hadd_ps(r2, r3)));
+            _mm_storeu_ps(im, _mm_hadd_ps(_mm_hadd_ps(i0, i1), _mm_hadd_ps(i2, i3)));
+#else
+            for (int j = 0; j < 4; ++j) re[j] = im[j] = 0.0f;
+            for (int t = 0; t < padded; ++t) {
+                float vc = cosRow[t];
+                float vs = sinRow[t];
+                re[0] += x0[t] * vc; im[0] += x0[t] * vs;
+                re[1] += x1[t] * vc; im[1] += x1[t] * vs;
+                re[2] += x2[t] * vc; im[2] += x2[t] * vs;
+                re[3] += x3[t] * vc; im[3] += x3[t] * vs;
+            }
+#endif
+            float* row = mMagnitude + static_cast<size_t>(b) * mLanes + c;
+            for (int j = 0; j < 4; ++j) {
+                row[j] = sqrtf(re[j] * re[j] + im[j] * im[j]);
+            }
+        }
+    }
+}
+
+// Power in the strongest HR-band bin and its neighbours over the rest of
+// the band. Taken over the whole band, not the tracking window, so a lane
+// locked onto the wrong peak still reports how clean it is.
+float MultiChannelProcessor::bandSnr(int c, int bandFirst, int bandLast) const {
+    auto power = [&](int k) {
+        float magnitude = mMagnitude[static_cast<size_t>(k - mFirstBin) * mLanes + c];
+        return magnitude * magnitude;
+    };
+    int peak = bandFirst;
+    for (int k = bandFirst + 1; k <= bandLast; ++k) {
+        if (power(k) > power(peak)) peak = k;
+    }
+    float peakPower = 0.0f;
+    for (int k = std::max(bandFirst, peak - 1); k <= std::min(bandLast, peak + 1); ++k) {
+        peakPower += power(k);
+    }
+    float rest = mBandPower[c] - peakPower;
+    return rest > 0.0f ? peakPower / rest : 0.0f;
+}
+
+void MultiChannelProcessor::trackPeaks() {
+    const float step = mSamplingRate / mBufferSize;
+    const int bandFirst = static_cast<int>(ceilf(kMinHrHz / step));
+    const int bandLast = static_cast<int>(floorf(kMaxHrHz / step));
+
+    // Smart search: narrow each locked channel to +/- 15 BPM of its last estimate
+    for (int c = 0; c < mLanes; ++c) {
+        float minFreq = kMinHrHz;
+        float maxFreq = kMaxHrHz;
+        if (mPrevHR[c] > 0.0f) {
+            float prevFreq = mPrevHR[c] / 60.0f;
+            float window = 15.0f / 60.0f;
+            minFreq = std::max(kMinHrHz, prevFreq - window);
+            maxFreq = std::min(kMaxHrHz, prevFreq + window);
+        }
+        mLo[c] = static_cast<int>(ceilf(minFreq / step));
+        mHi[c] = static_cast<int>(floorf(maxFreq / step));
+        mBest[c] = 0.0f;
+        mBandSum[c] = 0.0f;
+        mBandPower[c] = 0.0f;
+        mPeak[c] = -1;
+    }
+
+    // Bin-major sweep; the inner loop runs across channels
+    for (int k = bandFirst; k <= bandLast; ++k) {
+        const float* row = mMagnitude + static_cast<size_t>(k - mFirstBin) * mLanes;
+        for (int c = 0; c < mLanes; ++c) {
+            float magnitude = row[c];
+            mBandSum[c] += magnitude;
+            mBandPower[c] += magnitude * magnitude;
+            bool better = k >= mLo[c] && k <= mHi[c] && magnitude > mBest[c];
+            mBest[c] = better ? magnitude : mBest[c];
+            mPeak[c] = better ? k : mPeak[c];
+        }
+    }
+
+    const int count = bandLast - bandFirst + 1;
+    for (int c = 0; c < mChannels; ++c) {
+        mPeakFraction[c] = mBandPower[c] > 0.0f ? mBest[c] * mBest[c] / mBandPower[c] : 0.0f;
+        mSnr[c] = bandSnr(c, bandFirst, bandLast);
+        // Peak must be at least 2x the average noise
+        if (mPeak[c] == -1 || mBest[c] < 2.0f * mBandSum[c] / count) {
+            mResults[c] = mPrevHR[c];
+            continue;
+        }
+
+        // Parabolic refinement against the neighbouring (guard) bins
+        int row = mPeak[c] - mFirstBin;
+        float offset = 0.0f;
+        if (row > 0 && row + 1 < mBinCount) {
+            const float* peakRow = mMagnitude + static_cast<size_t>(row) * mLanes;
+            float a = peakRow[c - mLanes];
+            float b = peakRow[c];
+            float d = peakRow[c + mLanes];
+            float denom = a - 2.0f * b + d;
+            if (denom < 0.0f) offset = std::max(-0.5f, std::min(0.5f, 0.5f * (a - d) / denom));
+        }
+        float currentBpm = (mPeak[c] + offset) * step * 60.0f;
+
+        mPrevHR[c] = mPrevHR[c] > 0.0f ? mPrevHR[c] * 0.7f + currentBpm * 0.3f : currentBpm;
+        mResults[c] = mPrevHR[c];
+    }
+}
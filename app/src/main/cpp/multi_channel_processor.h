@@ -0,0 +1,94 @@
+// app/src/main/cpp/multi_channel_processor.h
+#ifndef OJAS_MULTI_CHANNEL_PROCESSOR_H
+#define OJAS_MULTI_CHANNEL_PROCESSOR_H
+
+#include <memory>
+#include "arena.h"
+#include "window_cache.h"
+
+/**
+ * Heart-rate estimator for K traces sampled together (several ROIs and/or
+ * faces), one K-vector per frame.
+ *
+ * Each channel keeps its own mirrored window, stored structure-of-arrays in
+ * one arena block. Analysis is batched across channels: the HR-band bins are
+ * evaluated as a matrix product of the windowed channels with a shared DFT
+ * basis, four channels per basis load, and the peak search runs bin-major
+ * over a [bin][channel] magnitude table. Only the ~30 HR-band bins are
+ * computed, instead of a full FFT per channel.
+ *
+ * Peak tracking per channel matches SignalProcessor's batch engine with a
+ * Hamming window and parabolic interpolation.
+ */
+class MultiChannelProcessor {
+public:
+    MultiChannelProcessor(int channels, int bufferSize, float samplingRate);
+
+    // values[c] is channel c's sample for this frame
+    void addFrame(const float* values);
+
+    // Replaces every channel's window with n samples (n <= buffer size), as
+    // if they had been added frame by frame; channel c starts at
+    // samples + c * stride. Peak tracking state is kept.
+    void setWindow(const float* samples, size_t stride, int n);
+
+    // One BPM per channel (0 until 3 s are in); valid until the next call
+    const float* computeHeartRates();
+
+    // Share of each channel's HR-band power (squared magnitudes) in its peak
+    // bin at the last computeHeartRates(); valid until the next call
+    const float* getPeakFraction() const { return mPeakFraction; }
+
+    // In-band SNR per channel at the last computeHeartRates(): power in the
+    // strongest HR-band bin and its neighbours over the rest of the band
+    const float* getSnr() const { return mSnr; }
+
+    // Each channel's total HR-band power at the last computeHeartRates()
+    const float* getBandPower() const { return mBandPower; }
+
+    int getChannelCount() const { return mChannels; }
+    int getSampleCount() const { return mSize; }
+    void reset();
+
+private:
+    int mChannels;
+    int mLanes;          // channels rounded up to a multiple of 4; extra lanes stay zero
+    int mBufferSize;
+    float mSamplingRate;
+    int mPaddedLength;   // buffer size rounded up to a multiple of 4
+
+    // Tracked bins: the HR band plus one guard bin each side for interpolation
+    int mFirstBin;
+    int mBinCount;
+
+    int mHead = 0;
+    int mSize = 0;
+
+    Arena mArena;
+    float* mSamples;     // lane c's mirrored window at mSamples + c * mStride
+    size_t mStride;
+    double* mSums;       // running sum of each window
+    float* mWindowed;    // lane c at mWindowed + c * mPaddedLength
+    float* mCos;         // basis row b at mCos + b * mPaddedLength: cos(2π(first+b)t/N)
+    float* mSin;
+    std::unique_ptr<WindowTables> mWindows;   // Hamming, 3 s up to the buffer size
+    float* mMagnitude;   // [bin][lane]
+    float* mPrevHR;
+    float* mResults;
+
+    // Per-lane peak search state
+    float* mBest;
+    float* mBandSum;
+    float* mBandPower;
+    float* mPeakFraction;
+    float* mSnr;
+    int* mPeak;
+    int* mLo;
+    int* mHi;
+
+    void computeMagnitudes(int n);
+    void trackPeaks();
+    float bandSnr(int c, int bandFirst, int bandLast) const;
+};
+
+#endif //OJAS_MULTI_CHANNEL_PROCESSOR_H
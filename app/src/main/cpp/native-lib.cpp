@@ -1,15 +1,92 @@
 // app/src/main/cpp/native-lib.cpp
 #include <jni.h>
+#include <algorithm>
 #include <string>
+#include <android/bitmap.h>
 #include <android/log.h>
-#include <arm_neon.h>
+#include "bss_processor.h"
+#include "chrom_processor.h"
+#include "frame_stats.h"
+#include "multi_channel_processor.h"
+#include "pos_processor.h"
+#include "roi_fusion.h"
+#include "roi_extractor.h"
 #include "signal_processor.h"
+#include "thread_pool.h"
 
 #define LOG_TAG "ojas-Native"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 
+/**
+ * Shared ROI plumbing for the JNI entry points: resolves up to kMaxRois ROIs'
+ * landmark indices to pixel coordinates on a width x height upright image,
+ * runs `stats` once over all of them (points, per-ROI point starts, ROI
+ * count, results) and writes kPackedRoiStats values per ROI into out.
+ */
+template <typename StatsFn>
+static int measureRois(JNIEnv* env, jfloatArray landmarks, jintArray polygonIndices,
+                       jintArray polygonStarts, jfloatArray out, int width, int height,
+                       StatsFn stats) {
+    int landmarkCount = env->GetArrayLength(landmarks) / 2;
+    int indexCount = env->GetArrayLength(polygonIndices);
+    int rois = std::min({env->GetArrayLength(polygonStarts) - 1,
+                         env->GetArrayLength(out) / kPackedRoiStats, kMaxRois});
+    if (rois <= 0) return 0;
+
+    jfloat* marks = env->GetFloatArrayElements(landmarks, nullptr);
+    jint* indices = env->GetIntArrayElements(polygonIndices, nullptr);
+    jint* starts = env->GetIntArrayElements(polygonStarts, nullptr);
+    int written = 0;
+
+    if (marks && indices && starts) {
+        // Landmark indices -> pixel coordinates, ROI after ROI
+        float points[2 * kMaxRoiPoints * kMaxRois];
+        int pointStarts[kMaxRois + 1];
+        int count = 0;
+        for (int r = 0; r < rois; ++r) {
+            pointStarts[r] = count;
+            int begin = std::max(0, starts[r]);
+            int end = std::min(indexCount, starts[r + 1]);
+            for (int i = begin; i < end && count - pointStarts[r] < kMaxRoiPoints; ++i) {
+                int index = indices[i];
+                if (index < 0 || index >= landmarkCount) continue;
+                points[2 * count] = marks[2 * index] * width;
+                points[2 * count + 1] = marks[2 * index + 1] * height;
+                ++count;
+            }
+        }
+        pointStarts[rois] = count;
+
+        RoiStats results[kMaxRois];
+        stats(points, pointStarts, rois, results);
+        jfloat packed[kPackedRoiStats * kMaxRois];
+        for (int r = 0; r < rois; ++r) {
+            const RoiStats& roi = results[r];
+            jfloat* p = packed + r * kPackedRoiStats;
+            p[0] = roi.mean[0]; p[1] = roi.mean[1]; p[2] = roi.mean[2];
+            p[3] = roi.variance[0]; p[4] = roi.variance[1]; p[5] = roi.variance[2];
+            p[6] = static_cast<jfloat>(roi.pixels);
+        }
+        env->SetFloatArrayRegion(out, 0, rois * kPackedRoiStats, packed);
+        written = rois;
+    }
+
+    if (starts) env->ReleaseIntArrayElements(polygonStarts, starts, JNI_ABORT);
+    if (indices) env->ReleaseIntArrayElements(polygonIndices, indices, JNI_ABORT);
+    if (marks) env->ReleaseFloatArrayElements(landmarks, marks, JNI_ABORT);
+    return written;
+}
+
 extern "C" {
 
+// Calibrates the frame pool's tiling threshold with this device's own
+// kernel cost, off the loading thread and before the camera needs the pool
+// (which uses the default threshold until this is done)
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM*, void*) {
+    std::thread([] { ThreadPool::frames().calibrate(roiNanosPerPixel()); }).detach();
+    return JNI_VERSION_1_6;
+}
+
 JNIEXPORT jlong JNICALL
 Java_com_pranshu_ojas_core_NativeSignalProcessor_nativeInit(JNIEnv* env, jobject, jint bufferSize, jfloat samplingRate) {
     auto* processor = new SignalProcessor(bufferSize, samplingRate);
@@ -22,73 +99,581 @@ Java_com_pranshu_ojas_core_NativeSignalProcessor_nativeRelease(JNIEnv* env, jobj
     if (processor) delete processor;
 }
 
+// Every entry point holds a WorkerRef while it runs, so stopWorker() cannot free
+// the worker underneath it: pauseWorker() where it touches the processor itself,
+// worker() where it only reads the worker's snapshot or queues a sample.
+
 JNIEXPORT void JNICALL
 Java_com_pranshu_ojas_core_NativeSignalProcessor_reset(JNIEnv* env, jobject, jlong handle) {
     auto* processor = reinterpret_cast<SignalProcessor*>(handle);
-    if (processor) processor->reset();
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->reset();
 }
 
 JNIEXPORT void JNICALL
 Java_com_pranshu_ojas_core_NativeSignalProcessor_addSample(JNIEnv* env, jobject, jlong handle, jfloat greenValue, jlong timestamp) {
     auto* processor = reinterpret_cast<SignalProcessor*>(handle);
-    if (processor) processor->addSample(greenValue, timestamp);
+    if (!processor) return;
+    auto worker = processor->worker();
+    if (worker) {
+        worker->offer(greenValue, timestamp);
+        return;
+    }
+    processor->addSample(greenValue, timestamp);
+}
+
+// Bulk ingestion: one transition for a whole batch of frames
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_addSamples(
+        JNIEnv* env, jobject, jlong handle, jfloatArray values, jlongArray timestamps) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    int count = std::min(env->GetArrayLength(values), env->GetArrayLength(timestamps));
+    if (count <= 0) return;
+
+    auto worker = processor->worker();
+    // Anything already queued in the shared ring is older than this batch
+    if (!worker) processor->drainInput();
+
+    static_assert(sizeof(jlong) == sizeof(int64_t), "jlong is 64 bits on every ABI");
+    auto* valueData = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(values, nullptr));
+    auto* timeData = static_cast<jlong*>(env->GetPrimitiveArrayCritical(timestamps, nullptr));
+    if (valueData && timeData) {
+        if (worker) {
+            for (int i = 0; i < count && worker->offer(valueData[i], timeData[i]); ++i) {}
+        } else {
+            processor->addSamples(valueData, reinterpret_cast<const int64_t*>(timeData), count);
+        }
+    }
+    if (timeData) env->ReleasePrimitiveArrayCritical(timestamps, timeData, JNI_ABORT);
+    if (valueData) env->ReleasePrimitiveArrayCritical(values, valueData, JNI_ABORT);
+}
+
+// Shared SPSC ring (see sample_ring.h). The Kotlin side keeps the buffer alive
+// until detachSampleRing() or nativeRelease().
+JNIEXPORT jboolean JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_attachSampleRing(JNIEnv* env, jobject, jlong handle, jobject buffer) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor || !buffer) return JNI_FALSE;
+    auto* memory = static_cast<uint8_t*>(env->GetDirectBufferAddress(buffer));
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (!memory || capacity <= 0) return JNI_FALSE;
+    auto guard = processor->pauseWorker();
+    return processor->attachInput(memory, static_cast<size_t>(capacity)) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_detachSampleRing(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->drainInput();
+    processor->detachInput();
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_startWorker(JNIEnv* env, jobject, jlong handle, jint intervalMs) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (processor) processor->startWorker(intervalMs);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_stopWorker(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (processor) processor->stopWorker();
+}
+
+// Packs the latest AnalysisResult into out (kPackedAnalysisResult floats). Never blocks.
+JNIEXPORT jboolean JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_getWorkerResult(JNIEnv* env, jobject, jlong handle, jfloatArray out) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return JNI_FALSE;
+    auto worker = processor->worker();
+    if (!worker || env->GetArrayLength(out) < kPackedAnalysisResult) return JNI_FALSE;
+    AnalysisResult result = worker->latest();
+    jfloat packed[kPackedAnalysisResult] = {
+            result.heartRate, result.respirationRate, result.peakToNoise,
+            result.effectiveFps, result.jitterMs,
+            static_cast<jfloat>(result.sampleCount), static_cast<jfloat>(result.sequence)};
+    env->SetFloatArrayRegion(out, 0, kPackedAnalysisResult, packed);
+    return JNI_TRUE;
 }
 
 JNIEXPORT jfloat JNICALL
 Java_com_pranshu_ojas_core_NativeSignalProcessor_getHeartRate(JNIEnv* env, jobject, jlong handle) {
     auto* processor = reinterpret_cast<SignalProcessor*>(handle);
-    if (processor) return processor->computeHeartRate();
-    return 0.0f;
+    if (!processor) return 0.0f;
+    auto worker = processor->worker();
+    if (worker) return worker->latest().heartRate;
+    processor->drainInput();
+    return processor->computeHeartRate();
+}
+
+JNIEXPORT jfloat JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_getRespirationRate(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return 0.0f;
+    auto worker = processor->worker();
+    if (worker) return worker->latest().respirationRate;
+    processor->drainInput();
+    return processor->computeRespirationRate();
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_setSpectralEngine(JNIEnv* env, jobject, jlong handle, jint engine) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->setSpectralEngine(static_cast<SpectralEngine>(engine));
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_setWindowType(JNIEnv* env, jobject, jlong handle, jint type) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->setWindowType(static_cast<WindowType>(type));
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_setRespirationEnabled(JNIEnv* env, jobject, jlong handle, jboolean enabled) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->setRespirationEnabled(enabled == JNI_TRUE);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_setFftLength(JNIEnv* env, jobject, jlong handle, jint length) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->setFftLength(length);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_setZoomResolution(JNIEnv* env, jobject, jlong handle, jfloat bpmStep) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->setZoomResolution(bpmStep);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_setPeakInterpolation(JNIEnv* env, jobject, jlong handle, jint mode) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->setPeakInterpolation(static_cast<PeakInterpolation>(mode));
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_setWelchOverlap(JNIEnv* env, jobject, jlong handle, jfloat overlap) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->setWelchOverlap(overlap);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_setResampleMode(JNIEnv* env, jobject, jlong handle, jint mode) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return;
+    auto guard = processor->pauseWorker();
+    processor->setResampleMode(static_cast<ResampleMode>(mode));
+}
+
+JNIEXPORT jfloat JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_getEffectiveFps(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return 0.0f;
+    auto worker = processor->worker();
+    if (worker) return worker->latest().effectiveFps;
+    processor->drainInput();
+    return processor->getEffectiveFps();
+}
+
+JNIEXPORT jfloat JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_getJitterMs(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    if (!processor) return 0.0f;
+    auto worker = processor->worker();
+    if (worker) return worker->latest().jitterMs;
+    processor->drainInput();
+    return processor->getJitterMs();
 }
 
 JNIEXPORT jfloatArray JNICALL
 Java_com_pranshu_ojas_core_NativeSignalProcessor_getBuffer(JNIEnv* env, jobject, jlong handle) {
     auto* processor = reinterpret_cast<SignalProcessor*>(handle);
     if (!processor) return nullptr;
-    const auto& buffer = processor->getBuffer();
-    jfloatArray result = env->NewFloatArray(buffer.size());
-    if (result) env->SetFloatArrayRegion(result, 0, buffer.size(), buffer.data());
+    auto guard = processor->pauseWorker();
+    processor->drainInput();
+    int count = processor->getSampleCount();
+    jfloatArray result = env->NewFloatArray(count);
+    if (result) env->SetFloatArrayRegion(result, 0, count, processor->getBuffer());
     return result;
 }
 
+// Copies the newest window into a direct FloatBuffer unless its sequence equals
+// knownSequence. Returns (sequence << 32) | samples in the buffer; allocates nothing.
+JNIEXPORT jlong JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_readWaveform(
+        JNIEnv* env, jobject, jlong handle, jobject buffer, jint knownSequence) {
+    auto* processor = reinterpret_cast<SignalProcessor*>(handle);
+    auto* out = buffer ? static_cast<float*>(env->GetDirectBufferAddress(buffer)) : nullptr;
+    if (!processor || !out) return 0;
+    jlong room = env->GetDirectBufferCapacity(buffer);
+
+    // With a worker the snapshot is kept current by its drains
+    auto worker = processor->worker();
+    if (!worker) {
+        processor->drainInput();
+        processor->publishWaveform();
+    }
+    int count = 0;
+    uint32_t sequence = processor->waveform().read(
+            out, static_cast<int>(std::min<jlong>(room, processor->waveform().capacity())),
+            static_cast<uint32_t>(knownSequence), &count);
+    return (static_cast<jlong>(sequence) << 32) | static_cast<uint32_t>(count);
+}
+
 JNIEXPORT jint JNICALL
 Java_com_pranshu_ojas_core_NativeSignalProcessor_getSampleCount(JNIEnv* env, jobject, jlong handle) {
     auto* processor = reinterpret_cast<SignalProcessor*>(handle);
-    if (processor) return processor->getSampleCount();
-    return 0;
+    if (!processor) return 0;
+    auto worker = processor->worker();
+    if (worker) return worker->latest().sampleCount;
+    processor->drainInput();
+    return processor->getSampleCount();
 }
 
 // --- OPTIMIZATION: NEON Accelerated Image Processing ---
 // You can mention this in your README as an Arm Optimization feature
+// Tightly packed RGBA frame in a Java array
 JNIEXPORT jfloat JNICALL
 Java_com_pranshu_ojas_core_NativeSignalProcessor_computeGreenAverage(
         JNIEnv* env, jobject, jbyteArray imageData, jint width, jint height) {
 
-    jbyte* pixels = env->GetByteArrayElements(imageData, nullptr);
-    int totalPixels = width * height;
+    // Elements, not a critical region: the reduction may wait on the frame
+    // pool's threads, which must not happen while the GC is held off
+    jsize length = env->GetArrayLength(imageData);
+    jbyte* elements = env->GetByteArrayElements(imageData, nullptr);
+    if (!elements) return 0.0f;
 
-    uint32x4_t sumVector = vdupq_n_u32(0);
-    int i = 0;
+    PlaneView plane{reinterpret_cast<const uint8_t*>(elements), static_cast<size_t>(length),
+                    width, height, width * 4, 4};
+    float average = planeFits(plane, 4)
+            ? averageChannel(plane, 1, 0, 0, width, height, &ThreadPool::frames())
+            : 0.0f;
 
-    // Process 16 pixels at a time using NEON
-    for (; i <= totalPixels - 16; i += 16) {
-        uint8x16x4_t pixelBlock = vld4q_u8(reinterpret_cast<uint8_t*>(&pixels[i * 4]));
-        uint8x16_t greenBytes = pixelBlock.val[1];
-        uint16x8_t high = vmovl_u8(vget_high_u8(greenBytes));
-        uint16x8_t low = vmovl_u8(vget_low_u8(greenBytes));
-        sumVector = vaddq_u32(sumVector, vpaddlq_u16(high));
-        sumVector = vaddq_u32(sumVector, vpaddlq_u16(low));
-    }
+    // Read-only: JNI_ABORT skips the copy-back
+    env->ReleaseByteArrayElements(imageData, elements, JNI_ABORT);
+    return average;
+}
 
-    float totalSum = vgetq_lane_u32(sumVector, 0) + vgetq_lane_u32(sumVector, 1) +
-                     vgetq_lane_u32(sumVector, 2) + vgetq_lane_u32(sumVector, 3);
+// Strided plane in a direct ByteBuffer (e.g. ImageProxy.planes[i].buffer), read in place.
+// Only the [left, left + roiWidth) x [top, top + roiHeight) rectangle is touched.
+JNIEXPORT jfloat JNICALL
+Java_com_pranshu_ojas_core_NativeSignalProcessor_computeChannelAverageDirect(
+        JNIEnv* env, jobject, jobject buffer, jint width, jint height, jint rowStride,
+        jint pixelStride, jint channel, jint left, jint top, jint roiWidth, jint roiHeight) {
+
+    auto* data = static_cast<const uint8_t*>(env->GetDirectBufferAddress(buffer));
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (!data || capacity <= 0) return 0.0f;
+
+    PlaneView plane{data, static_cast<size_t>(capacity), width, height, rowStride, pixelStride};
+    if (channel < 0 || channel >= pixelStride || !planeFits(plane, channel + 1)) return 0.0f;
+    return averageChannel(plane, channel, left, top, roiWidth, roiHeight, &ThreadPool::frames());
+}
+
+// --- Landmark polygon ROIs ---
+// ROI i is the convex hull of landmarks polygonIndices[polygonStarts[i] .. polygonStarts[i + 1]);
+// landmarks are normalized (x, y) pairs in upright image coordinates. Each ROI writes
+// (mean R, G, B, variance R, G, B, pixelCount) into out, all ROIs from one call into one
+// preallocated array; both entry points return the number of ROIs written (at most kMaxRois).
+
+JNIEXPORT jint JNICALL
+Java_com_pranshu_ojas_core_NativeRoiExtractor_computeRoiStats(
+        JNIEnv* env, jobject, jobject bitmap, jfloatArray landmarks,
+        jintArray polygonIndices, jintArray polygonStarts, jfloatArray out) {
 
-    for (; i < totalPixels; i++) {
-        totalSum += static_cast<uint8_t>(pixels[i * 4 + 1]);
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS ||
+        info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+        return 0;
     }
 
-    env->ReleaseByteArrayElements(imageData, pixels, 0);
-    return totalSum / totalPixels;
+    void* pixels = nullptr;
+    if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) return 0;
+    PlaneView plane{static_cast<const uint8_t*>(pixels),
+                    static_cast<size_t>(info.stride) * info.height,
+                    static_cast<int>(info.width), static_cast<int>(info.height),
+                    static_cast<int>(info.stride), 4};
+
+    int written = measureRois(env, landmarks, polygonIndices, polygonStarts, out,
+                              plane.width, plane.height,
+                              [&](const float* points, const int* starts, int rois, RoiStats* results) {
+        for (int r = 0; r < rois; ++r) {
+            results[r] = convexRoiStats(plane, points + 2 * starts[r], starts[r + 1] - starts[r],
+                                        &ThreadPool::frames());
+        }
+    });
+    AndroidBitmap_unlockPixels(env, bitmap);
+    return written;
+}
+
+// YUV_420_888 planes as direct ByteBuffers (ImageProxy.planes), read in place.
+// rotation is ImageInfo.getRotationDegrees(); width / height are the sensor-oriented size.
+// skinOnly restricts every ROI to pixels passing the default SkinThresholds.
+JNIEXPORT jint JNICALL
+Java_com_pranshu_ojas_core_NativeRoiExtractor_computeRoiStatsYuv(
+        JNIEnv* env, jobject, jobject yBuffer, jobject uBuffer, jobject vBuffer,
+        jint width, jint height, jint yRowStride, jint yPixelStride,
+        jint uvRowStride, jint uvPixelStride, jint rotation,
+        jint cropLeft, jint cropTop, jint cropRight, jint cropBottom, jboolean skinOnly,
+        jfloatArray landmarks, jintArray polygonIndices, jintArray polygonStarts, jfloatArray out) {
+
+    auto plane = [env](jobject buffer, int w, int h, int rowStride, int pixelStride) {
+        return PlaneView{static_cast<const uint8_t*>(env->GetDirectBufferAddress(buffer)),
+                         static_cast<size_t>(std::max<jlong>(0, env->GetDirectBufferCapacity(buffer))),
+                         w, h, rowStride, pixelStride};
+    };
+    YuvFrame frame{plane(yBuffer, width, height, yRowStride, yPixelStride),
+                   plane(uBuffer, (width + 1) / 2, (height + 1) / 2, uvRowStride, uvPixelStride),
+                   plane(vBuffer, (width + 1) / 2, (height + 1) / 2, uvRowStride, uvPixelStride),
+                   rotation, cropLeft, cropTop, cropRight, cropBottom};
+    if (!planeFits(frame.y) || !planeFits(frame.u) || !planeFits(frame.v)) return 0;
+
+    static const SkinThresholds kSkin;
+    const SkinThresholds* skin = skinOnly ? &kSkin : nullptr;
+    bool sideways = rotation == 90 || rotation == 270;
+    return measureRois(env, landmarks, polygonIndices, polygonStarts, out,
+                       sideways ? height : width, sideways ? width : height,
+                       [&](const float* points, const int* starts, int rois, RoiStats* results) {
+        convexRoiStatsYuv(frame, points, starts, rois, results, &ThreadPool::frames(), skin);
+    });
+}
+
+// --- Multi-channel processor (several ROIs / faces per handle) ---
+
+JNIEXPORT jlong JNICALL
+Java_com_pranshu_ojas_core_NativeMultiChannelProcessor_nativeInit(JNIEnv* env, jobject, jint channels, jint bufferSize, jfloat samplingRate) {
+    auto* processor = new MultiChannelProcessor(channels, bufferSize, samplingRate);
+    return reinterpret_cast<jlong>(processor);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeMultiChannelProcessor_nativeRelease(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<MultiChannelProcessor*>(handle);
+    if (processor) delete processor;
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeMultiChannelProcessor_reset(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<MultiChannelProcessor*>(handle);
+    if (processor) processor->reset();
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeMultiChannelProcessor_addFrame(JNIEnv* env, jobject, jlong handle, jfloatArray values) {
+    auto* processor = reinterpret_cast<MultiChannelProcessor*>(handle);
+    if (!processor || env->GetArrayLength(values) < processor->getChannelCount()) return;
+    auto* frame = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(values, nullptr));
+    if (!frame) return;
+    processor->addFrame(frame);
+    env->ReleasePrimitiveArrayCritical(values, frame, JNI_ABORT);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeMultiChannelProcessor_getHeartRates(JNIEnv* env, jobject, jlong handle, jfloatArray out) {
+    auto* processor = reinterpret_cast<MultiChannelProcessor*>(handle);
+    if (!processor) return;
+    int count = std::min<int>(processor->getChannelCount(), env->GetArrayLength(out));
+    env->SetFloatArrayRegion(out, 0, count, processor->computeHeartRates());
+}
+
+JNIEXPORT jint JNICALL
+Java_com_pranshu_ojas_core_NativeMultiChannelProcessor_getSampleCount(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<MultiChannelProcessor*>(handle);
+    if (processor) return processor->getSampleCount();
+    return 0;
+}
+
+// --- CHROM pulse extraction (RGB means in, one pulse sample per ROI out) ---
+
+JNIEXPORT jlong JNICALL
+Java_com_pranshu_ojas_core_NativeChromProcessor_nativeInit(JNIEnv* env, jobject, jint channels, jfloat samplingRate, jfloat windowSeconds) {
+    auto* processor = new ChromProcessor(channels, samplingRate, windowSeconds);
+    return reinterpret_cast<jlong>(processor);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeChromProcessor_nativeRelease(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<ChromProcessor*>(handle);
+    if (processor) delete processor;
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeChromProcessor_reset(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<ChromProcessor*>(handle);
+    if (processor) processor->reset();
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_pranshu_ojas_core_NativeChromProcessor_process(JNIEnv* env, jobject, jlong handle, jfloatArray rgb, jfloatArray out) {
+    auto* processor = reinterpret_cast<ChromProcessor*>(handle);
+    if (!processor) return JNI_FALSE;
+    int channels = processor->getChannelCount();
+    if (env->GetArrayLength(rgb) < 3 * channels || env->GetArrayLength(out) < channels) return JNI_FALSE;
+    auto* frame = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(rgb, nullptr));
+    if (!frame) return JNI_FALSE;
+    const float* pulse = processor->process(frame);
+    env->ReleasePrimitiveArrayCritical(rgb, frame, JNI_ABORT);
+    env->SetFloatArrayRegion(out, 0, channels, pulse);
+    return JNI_TRUE;
+}
+
+// --- POS pulse extraction (output lags input by latencyFrames()) ---
+
+JNIEXPORT jlong JNICALL
+Java_com_pranshu_ojas_core_NativePosProcessor_nativeInit(JNIEnv* env, jobject, jint channels, jfloat samplingRate, jfloat windowSeconds) {
+    auto* processor = new PosProcessor(channels, samplingRate, windowSeconds);
+    return reinterpret_cast<jlong>(processor);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativePosProcessor_nativeRelease(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<PosProcessor*>(handle);
+    if (processor) delete processor;
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativePosProcessor_reset(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<PosProcessor*>(handle);
+    if (processor) processor->reset();
+}
+
+JNIEXPORT jint JNICALL
+Java_com_pranshu_ojas_core_NativePosProcessor_getLatencyFrames(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<PosProcessor*>(handle);
+    if (processor) return processor->latencyFrames();
+    return 0;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_pranshu_ojas_core_NativePosProcessor_process(JNIEnv* env, jobject, jlong handle, jfloatArray rgb, jfloatArray out) {
+    auto* processor = reinterpret_cast<PosProcessor*>(handle);
+    if (!processor) return JNI_FALSE;
+    int channels = processor->getChannelCount();
+    if (env->GetArrayLength(rgb) < 3 * channels || env->GetArrayLength(out) < channels) return JNI_FALSE;
+    auto* frame = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(rgb, nullptr));
+    if (!frame) return JNI_FALSE;
+    const float* pulse = processor->process(frame);
+    env->ReleasePrimitiveArrayCritical(rgb, frame, JNI_ABORT);
+    if (!pulse) return JNI_FALSE;
+    env->SetFloatArrayRegion(out, 0, channels, pulse);
+    return JNI_TRUE;
+}
+
+// --- SNR-weighted fusion of per-ROI pulse traces ---
+
+JNIEXPORT jlong JNICALL
+Java_com_pranshu_ojas_core_NativeRoiFusion_nativeInit(JNIEnv* env, jobject, jint channels, jint bufferSize, jfloat samplingRate) {
+    auto* fusion = new RoiFusion(channels, bufferSize, samplingRate);
+    return reinterpret_cast<jlong>(fusion);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeRoiFusion_nativeRelease(JNIEnv* env, jobject, jlong handle) {
+    auto* fusion = reinterpret_cast<RoiFusion*>(handle);
+    if (fusion) delete fusion;
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeRoiFusion_reset(JNIEnv* env, jobject, jlong handle) {
+    auto* fusion = reinterpret_cast<RoiFusion*>(handle);
+    if (fusion) fusion->reset();
+}
+
+JNIEXPORT jfloat JNICALL
+Java_com_pranshu_ojas_core_NativeRoiFusion_addFrame(JNIEnv* env, jobject, jlong handle, jfloatArray values) {
+    auto* fusion = reinterpret_cast<RoiFusion*>(handle);
+    if (!fusion || env->GetArrayLength(values) < fusion->getChannelCount()) return 0.0f;
+    auto* frame = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(values, nullptr));
+    if (!frame) return 0.0f;
+    float fused = fusion->addFrame(frame);
+    env->ReleasePrimitiveArrayCritical(values, frame, JNI_ABORT);
+    return fused;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_pranshu_ojas_core_NativeRoiFusion_getWeights(JNIEnv* env, jobject, jlong handle, jfloatArray out) {
+    auto* fusion = reinterpret_cast<RoiFusion*>(handle);
+    if (!fusion) return 0;
+    jsize count = std::min(env->GetArrayLength(out), static_cast<jsize>(fusion->getChannelCount()));
+    env->SetFloatArrayRegion(out, 0, count, fusion->getWeights());
+    return count;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_pranshu_ojas_core_NativeRoiFusion_getSnr(JNIEnv* env, jobject, jlong handle, jfloatArray out) {
+    auto* fusion = reinterpret_cast<RoiFusion*>(handle);
+    if (!fusion) return 0;
+    jsize count = std::min(env->GetArrayLength(out), static_cast<jsize>(fusion->getChannelCount()));
+    env->SetFloatArrayRegion(out, 0, count, fusion->getSnr());
+    return count;
+}
+
+// --- Blind source separation (ICA over the windowed RGB traces) ---
+
+JNIEXPORT jlong JNICALL
+Java_com_pranshu_ojas_core_NativeBssProcessor_nativeInit(JNIEnv* env, jobject, jint bufferSize, jfloat samplingRate) {
+    auto* processor = new BssProcessor(bufferSize, samplingRate);
+    return reinterpret_cast<jlong>(processor);
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeBssProcessor_nativeRelease(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<BssProcessor*>(handle);
+    if (processor) delete processor;
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeBssProcessor_reset(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<BssProcessor*>(handle);
+    if (processor) processor->reset();
+}
+
+JNIEXPORT void JNICALL
+Java_com_pranshu_ojas_core_NativeBssProcessor_addFrame(JNIEnv* env, jobject, jlong handle, jfloat r, jfloat g, jfloat b) {
+    auto* processor = reinterpret_cast<BssProcessor*>(handle);
+    if (processor) processor->addFrame(r, g, b);
+}
+
+JNIEXPORT jfloat JNICALL
+Java_com_pranshu_ojas_core_NativeBssProcessor_getHeartRate(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<BssProcessor*>(handle);
+    if (processor) return processor->computeHeartRate();
+    return 0.0f;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_pranshu_ojas_core_NativeBssProcessor_getComponent(JNIEnv* env, jobject, jlong handle, jfloatArray out) {
+    auto* processor = reinterpret_cast<BssProcessor*>(handle);
+    if (!processor) return 0;
+    int count = std::min<int>(processor->getComponentLength(), env->GetArrayLength(out));
+    env->SetFloatArrayRegion(out, 0, count, processor->getComponent());
+    return count;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_pranshu_ojas_core_NativeBssProcessor_getSampleCount(JNIEnv* env, jobject, jlong handle) {
+    auto* processor = reinterpret_cast<BssProcessor*>(handle);
+    if (processor) return processor->getSampleCount();
+    return 0;
 }
 
 } // extern "C"
\ No newline at end of file
@@ -0,0 +1,127 @@
+// app/src/main/cpp/pos_processor.cpp
+#include "pos_processor.h"
+#include <algorithm>
+#include <cmath>
+
+static int roundUp4(int n) {
+    return (n + 3) & ~3;
+}
+
+PosProcessor::PosProcessor(int channels, float samplingRate, float windowSeconds)
+        : mChannels(std::max(1, channels)) {
+    mLanes = roundUp4(mChannels);
+    mWindow = std::max(2, static_cast<int>(lroundf(windowSeconds * samplingRate)));
+
+    size_t lanes = mLanes;
+    mArena.reset(Arena::bytesFor<float>(3 * mWindow * lanes) +
+                 Arena::bytesFor<double>(3 * lanes) +
+                 Arena::bytesFor<double>(6 * lanes) +
+                 Arena::bytesFor<float>(4 * mWindow * lanes) +
+                 Arena::bytesFor<double>(4 * lanes) +
+                 2 * Arena::bytesFor<float>(lanes));
+
+    mRgb = mArena.allocate<float>(3 * mWindow * lanes);
+    mSums = mArena.allocate<double>(3 * lanes);
+    mMoments = mArena.allocate<double>(6 * lanes);
+    mWeights = mArena.allocate<float>(4 * mWindow * lanes);
+    mWeightSums = mArena.allocate<double>(4 * lanes);
+    mAlpha = mArena.allocate<float>(lanes);
+    mResults = mArena.allocate<float>(lanes);
+    reset();
+}
+
+void PosProcessor::reset() {
+    mHead = 0;
+    mSize = 0;
+    size_t lanes = mLanes;
+    std::fill(mRgb, mRgb + 3 * mWindow * lanes, 0.0f);
+    std::fill(mSums, mSums + 3 * lanes, 0.0);
+    std::fill(mMoments, mMoments + 6 * lanes, 0.0);
+    std::fill(mWeights, mWeights + 4 * mWindow * lanes, 0.0f);
+    std::fill(mWeightSums, mWeightSums + 4 * lanes, 0.0);
+    std::fill(mAlpha, mAlpha + lanes, 0.0f);
+    std::fill(mResults, mResults + lanes, 0.0f);
+}
+
+const float* PosProcessor::process(const float* rgb) {
+    const int lanes = mLanes;
+    const size_t slotSize = static_cast<size_t>(lanes);
+
+    // 1. Slide the window: running sums and products of the colours. The slot
+    // being replaced holds the frame l ago (zeros while the window fills).
+    float* slot = mRgb + mHead * 3 * slotSize;
+    double* sumR = mSums;
+    double* sumG = mSums + lanes;
+    double* sumB = mSums + 2 * lanes;
+    double* rr = mMoments;
+    double* gg = mMoments + lanes;
+    double* bb = mMoments + 2 * lanes;
+    double* rg = mMoments + 3 * lanes;
+    double* rb = mMoments + 4 * lanes;
+    double* gb = mMoments + 5 * lanes;
+    for (int c = 0; c < mChannels; ++c) {
+        double r = rgb[3 * c], g = rgb[3 * c + 1], b = rgb[3 * c + 2];
+        double oldR = slot[c], oldG = slot[lanes + c], oldB = slot[2 * lanes + c];
+        sumR[c] += r - oldR;
+        sumG[c] += g - oldG;
+        sumB[c] += b - oldB;
+        rr[c] += r * r - oldR * oldR;
+        gg[c] += g * g - oldG * oldG;
+        bb[c] += b * b - oldB * oldB;
+        rg[c] += r * g - oldR * oldG;
+        rb[c] += r * b - oldR * oldB;
+        gb[c] += g * b - oldG * oldB;
+        slot[c] = rgb[3 * c];
+        slot[lanes + c] = rgb[3 * c + 1];
+        slot[2 * lanes + c] = rgb[3 * c + 2];
+    }
+
+    const int head = mHead;
+    if (++mHead == mWindow) mHead = 0;
+    if (mSize < mWindow && ++mSize < mWindow) return nullptr;
+
+    // 2. This window's projection: S1 = a . C and S2 = b . C with the mean
+    // normalisation folded into a and b, h = (a + alpha b) . (C - mean)
+    const double invCount = 1.0 / mWindow;
+    float* weights = mWeights + head * 4 * slotSize;
+    const float* oldest = mRgb + mHead * 3 * slotSize;   // frame whose sample is now final
+    double* sumW[4] = {mWeightSums, mWeightSums + lanes, mWeightSums + 2 * lanes,
+                       mWeightSums + 3 * lanes};
+    for (int c = 0; c < mChannels; ++c) {
+        double mean[3] = {sumR[c] * invCount, sumG[c] * invCount, sumB[c] * invCount};
+        double w[4] = {0.0, 0.0, 0.0, 0.0};
+        float alpha = 0.0f;
+        if (mean[0] > 0.0 && mean[1] > 0.0 && mean[2] > 0.0) {
+            double cRR = rr[c] * invCount - mean[0] * mean[0];
+            double cGG = gg[c] * invCount - mean[1] * mean[1];
+            double cBB = bb[c] * invCount - mean[2] * mean[2];
+            double cRG = rg[c] * invCount - mean[0] * mean[1];
+            double cRB = rb[c] * invCount - mean[0] * mean[2];
+            double cGB = gb[c] * invCount - mean[1] * mean[2];
+            double a[3] = {0.0, 1.0 / mean[1], -1.0 / mean[2]};
+            double b[3] = {-2.0 / mean[0], 1.0 / mean[1], 1.0 / mean[2]};
+            auto variance = [&](const double* v) {
+                return v[0] * v[0] * cRR + v[1] * v[1] * cGG + v[2] * v[2] * cBB +
+                       2.0 * (v[0] * v[1] * cRG + v[0] * v[2] * cRB + v[1] * v[2] * cGB);
+            };
+            double var1 = std::max(0.0, variance(a));
+            double var2 = std::max(0.0, variance(b));
+            alpha = var2 > 1e-12 ? static_cast<float>(sqrt(var1 / var2)) : 0.0f;
+            for (int k = 0; k < 3; ++k) w[k] = a[k] + alpha * b[k];
+            w[3] = w[0] * mean[0] + w[1] * mean[1] + w[2] * mean[2];
+        }
+        mAlpha[c] = alpha;
+
+        // 3. Overlap-add: the oldest frame's sample sums h over the l windows
+        // holding it, i.e. (sum of w) . C - sum of (w . mean)
+        for (int k = 0; k < 4; ++k) {
+            float* cell = weights + k * lanes + c;
+            float value = static_cast<float>(w[k]);
+            sumW[k][c] += static_cast<double>(value) - *cell;
+            *cell = value;
+        }
+        mResults[c] = static_cast<float>(sumW[0][c] * oldest[c] + sumW[1][c] * oldest[lanes + c] +
+                                         sumW[2][c] * oldest[2 * lanes + c] - sumW[3][c]);
+    }
+    return mResults;
+}
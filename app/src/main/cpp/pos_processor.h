@@ -0,0 +1,59 @@
+// app/src/main/cpp/pos_processor.h
+#ifndef OJAS_POS_PROCESSOR_H
+#define OJAS_POS_PROCESSOR_H
+
+#include "arena.h"
+
+/**
+ * POS (plane orthogonal to skin, Wang et al. 2017) pulse extraction for K
+ * ROIs sampled together, one mean RGB triple per ROI per frame in.
+ *
+ * For the window of the last l frames, POS normalises each channel by its
+ * window mean, projects onto S1 = G' - B' and S2 = -2R' + G' + B', forms
+ * h = S1 + (std S1 / std S2) S2 and overlap-adds h - mean(h) into the
+ * output. Every step is linear in the colours, so the window's h is
+ * w . (C - mean C) for one 3-vector w, and its standard deviations follow
+ * from the window's 3x3 covariance. Keeping running colour moments and a
+ * running sum of the last l windows' w turns the per-window matrix work
+ * and the overlap-add into O(1) per frame.
+ *
+ * A frame's sample is final once the l windows containing it are in, so
+ * output lags input by latencyFrames(). State is structure-of-arrays over
+ * ROI lanes (padded to a multiple of 4) in one arena block.
+ */
+class PosProcessor {
+public:
+    PosProcessor(int channels, float samplingRate, float windowSeconds = 1.6f);
+
+    // rgb[3c .. 3c + 2] is ROI c's mean R, G, B for this frame. Returns one
+    // pulse sample per ROI for the frame latencyFrames() ago, valid until
+    // the next call, or nullptr while the first window fills.
+    const float* process(const float* rgb);
+
+    int latencyFrames() const { return mWindow - 1; }
+
+    // std(S1) / std(S2) of ROI c's newest window
+    float alpha(int channel) const { return mAlpha[channel]; }
+
+    int getChannelCount() const { return mChannels; }
+    void reset();
+
+private:
+    int mChannels;
+    int mLanes;          // channels rounded up to a multiple of 4; extra lanes stay zero
+    int mWindow;         // l, frames per window
+
+    int mHead = 0;
+    int mSize = 0;
+
+    Arena mArena;
+    float* mRgb;         // [slot][R/G/B][lane] the last l frames
+    double* mSums;       // [R/G/B][lane] running sums over the window
+    double* mMoments;    // [RR, GG, BB, RG, RB, GB][lane] running products
+    float* mWeights;     // [slot][w R/G/B, w . mean][lane] the last l windows
+    double* mWeightSums; // [w R/G/B, w . mean][lane] running sums of mWeights
+    float* mAlpha;
+    float* mResults;
+};
+
+#endif //OJAS_POS_PROCESSOR_H
@@ -0,0 +1,127 @@
+// app/src/main/cpp/psd_estimator.cpp
+#include "psd_estimator.h"
+#include "window_cache.h"
+#include <algorithm>
+#include <cmath>
+
+// Accumulate |X[k]|^2 into power
+static void accumulatePower(const kiss_fft_cpx* spectrum, int bins, float* power) {
+    for (int k = 0; k < bins; ++k) {
+        power[k] += spectrum[k].r * spectrum[k].r + spectrum[k].i * spectrum[k].i;
+    }
+}
+
+static int evenLength(int n) {
+    return n + (n & 1);
+}
+
+static size_t planBytes(int nfft) {
+    size_t bytes = 0;
+    kiss_fftr_alloc(nfft, 0, nullptr, &bytes);
+    return bytes;
+}
+
+static kiss_fftr_cfg allocatePlan(int nfft, Arena& arena) {
+    size_t bytes = planBytes(nfft);
+    return kiss_fftr_alloc(nfft, 0, arena.allocate<char>(bytes), &bytes);
+}
+
+// --- Welch ---
+
+size_t WelchEstimator::arenaBytes(int segmentLength, int minLength) {
+    int n = evenLength(segmentLength);
+    return Arena::bytesFor<char>(planBytes(n)) + Arena::bytesFor<float>(n) +
+           Arena::bytesFor<kiss_fft_cpx>(n / 2 + 1) + Arena::bytesFor<float>(n / 2 + 1) +
+           WindowTables::arenaBytes(minLength, n);
+}
+
+WelchEstimator::WelchEstimator(int segmentLength, int minLength, float overlap, Arena& arena)
+        : mSegmentLength(evenLength(segmentLength)),
+          mFftCfg(allocatePlan(mSegmentLength, arena)),
+          mSegment(arena.allocate<float>(mSegmentLength)),
+          mSpectrum(arena.allocate<kiss_fft_cpx>(mSegmentLength / 2 + 1)),
+          mPower(arena.allocate<float>(mSegmentLength / 2 + 1)),
+          mWindows(minLength, mSegmentLength, arena) {
+    setOverlap(overlap);
+    mWindows.fill(WindowType::Hann);
+}
+
+void WelchEstimator::setOverlap(float overlap) {
+    overlap = std::max(0.0f, std::min(0.9f, overlap));
+    mHop = std::max(1, static_cast<int>(lroundf(mSegmentLength * (1.0f - overlap))));
+}
+
+void WelchEstimator::estimate(const float* x, int n, float mean, float* out) {
+    const int bins = mSegmentLength / 2 + 1;
+    std::fill(mPower, mPower + bins, 0.0f);
+
+    int used = mWindows.length(std::min(n, mSegmentLength));
+    if (used == 0) {
+        std::fill(out, out + bins, 0.0f);
+        return;
+    }
+    const float* window = mWindows.get(used);
+
+    // Segments end at the newest sample and step back by the hop
+    int segments = 0;
+    for (int end = n; end - used >= 0; end -= mHop) {
+        removeMeanAndWindow(x + end - used, window, mean, used, mSegment);
+        std::fill(mSegment + used, mSegment + mSegmentLength, 0.0f);
+        kiss_fftr(mFftCfg, mSegment, mSpectrum);
+        accumulatePower(mSpectrum, bins, mPower);
+        ++segments;
+        if (used < mSegmentLength) break;
+    }
+
+    const float scale = segments > 0 ? 1.0f / segments : 0.0f;
+    for (int k = 0; k < bins; ++k) {
+        out[k] = sqrtf(mPower[k] * scale);
+    }
+}
+
+// --- Multitaper ---
+
+size_t MultitaperEstimator::arenaBytes(int maxLength, int minLength, int tapers) {
+    int n = evenLength(maxLength);
+    return Arena::bytesFor<char>(planBytes(n)) +
+           WindowTables::arenaBytes(minLength, n, tapers) + Arena::bytesFor<float>(n) +
+           Arena::bytesFor<kiss_fft_cpx>(n / 2 + 1) + Arena::bytesFor<float>(n / 2 + 1);
+}
+
+MultitaperEstimator::MultitaperEstimator(int maxLength, int minLength, float nw, int tapers,
+                                         Arena& arena)
+        : mMaxLength(evenLength(maxLength)), mNw(nw), mTaperCount(tapers),
+          mFftCfg(allocatePlan(mMaxLength, arena)),
+          mTapers(minLength, mMaxLength, arena, tapers) {
+    mTapered = arena.allocate<float>(mMaxLength);
+    mSpectrum = arena.allocate<kiss_fft_cpx>(mMaxLength / 2 + 1);
+    mPower = arena.allocate<float>(mMaxLength / 2 + 1);
+
+    // Every taper set the analysis can ask for, so the Sturm bisection never
+    // runs while the window fills
+    mTapers.fillDpss(mNw);
+}
+
+void MultitaperEstimator::estimate(const float* x, int n, float mean, float* out) {
+    const int bins = mMaxLength / 2 + 1;
+    int used = mTapers.length(std::min(n, mMaxLength));
+    if (used == 0) {
+        std::fill(out, out + bins, 0.0f);
+        return;
+    }
+    x += n - used;
+    n = used;
+
+    std::fill(mPower, mPower + bins, 0.0f);
+    std::fill(mTapered + n, mTapered + mMaxLength, 0.0f);
+    for (int t = 0; t < mTaperCount; ++t) {
+        removeMeanAndWindow(x, mTapers.get(n, t), mean, n, mTapered);
+        kiss_fftr(mFftCfg, mTapered, mSpectrum);
+        accumulatePower(mSpectrum, bins, mPower);
+    }
+
+    const float scale = 1.0f / mTaperCount;
+    for (int k = 0; k < bins; ++k) {
+        out[k] = sqrtf(mPower[k] * scale);
+    }
+}
@@ -0,0 +1,84 @@
+// app/src/main/cpp/psd_estimator.h
+#ifndef OJAS_PSD_ESTIMATOR_H
+#define OJAS_PSD_ESTIMATOR_H
+
+#include "arena.h"
+#include "kiss_fftr.h"
+#include "window_cache.h"
+
+/**
+ * Averaged power-spectrum estimator. Implementations carve their FFT plan and
+ * scratch memory from an Arena once and reuse them for every segment /
+ * taper of every call.
+ */
+class PsdEstimator {
+public:
+    virtual ~PsdEstimator() = default;
+
+    /**
+     * Estimate the spectrum of n samples (oldest first, n <= maxLength).
+     * Implementations may analyse only the newest samples, down to the
+     * nearest window length they hold a table for (see WindowTables).
+     * Writes bins() amplitude values sqrt(PSD) so the result is on the same
+     * scale as a single periodogram's magnitudes.
+     */
+    virtual void estimate(const float* x, int n, float mean, float* out) = 0;
+
+    // Number of output bins and the transform length that sets their spacing
+    // (bin i is at i * samplingRate / transformLength())
+    virtual int bins() const = 0;
+    virtual int transformLength() const = 0;
+};
+
+/**
+ * Welch: Hann-windowed, overlapping segments of segmentLength samples,
+ * anchored at the newest sample. Shorter inputs, down to minLength, make a
+ * single shorter segment.
+ */
+class WelchEstimator : public PsdEstimator {
+public:
+    WelchEstimator(int segmentLength, int minLength, float overlap, Arena& arena);
+    static size_t arenaBytes(int segmentLength, int minLength);
+
+    void setOverlap(float overlap);
+
+    void estimate(const float* x, int n, float mean, float* out) override;
+    int bins() const override { return mSegmentLength / 2 + 1; }
+    int transformLength() const override { return mSegmentLength; }
+
+private:
+    int mSegmentLength;
+    int mHop;
+    kiss_fftr_cfg mFftCfg;
+    float* mSegment;
+    kiss_fft_cpx* mSpectrum;
+    float* mPower;
+    WindowTables mWindows;
+};
+
+/**
+ * Thomson multitaper: average of the periodograms under the first `tapers`
+ * DPSS tapers with time-bandwidth product nw. Taper sets for lengths from
+ * minLength up are computed at construction.
+ */
+class MultitaperEstimator : public PsdEstimator {
+public:
+    MultitaperEstimator(int maxLength, int minLength, float nw, int tapers, Arena& arena);
+    static size_t arenaBytes(int maxLength, int minLength, int tapers);
+
+    void estimate(const float* x, int n, float mean, float* out) override;
+    int bins() const override { return mMaxLength / 2 + 1; }
+    int transformLength() const override { return mMaxLength; }
+
+private:
+    int mMaxLength;
+    float mNw;
+    int mTaperCount;
+    kiss_fftr_cfg mFftCfg;
+    WindowTables mTapers;
+    float* mTapered;
+    kiss_fft_cpx* mSpectrum;
+    float* mPower;
+};
+
+#endif //OJAS_PSD_ESTIMATOR_H
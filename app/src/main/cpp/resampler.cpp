@@ -0,0 +1,191 @@
+// app/src/main/cpp/resampler.cpp
+#include "resampler.h"
+#include <cmath>
+
+#ifdef USE_NEON
+#include <arm_neon.h>
+#elif defined(USE_SSE)
+#include <immintrin.h>
+#endif
+
+// Weight of the newest interval in the frame-rate statistics
+static constexpr double kStatsAlpha = 0.05;
+
+// out[k] = c0 + u (c1 + u (c2 + u c3)) with u = uStart + k uStep, k < count.
+// A push after a dropped frame or from a slow camera emits several grid
+// points, which are evaluated four at a time.
+static void evaluateGrid(float c0, float c1, float c2, float c3, float uStart, float uStep,
+                         int count, float* out) {
+    int k = 0;
+#ifdef USE_NEON
+    const float lanes[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    float32x4_t u = vmlaq_n_f32(vdupq_n_f32(uStart), vld1q_f32(lanes), uStep);
+    const float32x4_t du = vdupq_n_f32(4.0f * uStep);
+    for (; k <= count - 4; k += 4) {
+        float32x4_t p = vmlaq_n_f32(vdupq_n_f32(c2), u, c3);
+        p = vmlaq_f32(vdupq_n_f32(c1), u, p);
+        p = vmlaq_f32(vdupq_n_f32(c0), u, p);
+        vst1q_f32(out + k, p);
+        u = vaddq_f32(u, du);
+    }
+#elif defined(USE_SSE)
+    __m128 u = _mm_add_ps(_mm_set1_ps(uStart),
+                          _mm_mul_ps(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f), _mm_set1_ps(uStep)));
+    const __m128 du = _mm_set1_ps(4.0f * uStep);
+    const __m128 v0 = _mm_set1_ps(c0), v1 = _mm_set1_ps(c1);
+    const __m128 v2 = _mm_set1_ps(c2), v3 = _mm_set1_ps(c3);
+    for (; k <= count - 4; k += 4) {
+        __m128 p = _mm_add_ps(v2, _mm_mul_ps(u, v3));
+        p = _mm_add_ps(v1, _mm_mul_ps(u, p));
+        p = _mm_add_ps(v0, _mm_mul_ps(u, p));
+        _mm_storeu_ps(out + k, p);
+        u = _mm_add_ps(u, du);
+    }
+#endif
+    for (; k < count; ++k) {
+        float u = uStart + uStep * k;
+        out[k] = c0 + u * (c1 + u * (c2 + u * c3));
+    }
+}
+
+UniformResampler::UniformResampler(float targetRate, ResampleMode mode)
+        : mPeriodMs(1000.0 / targetRate), mMode(mode) {
+}
+
+int UniformResampler::maxOutputsPerPush() const {
+    return static_cast<int>(ceil(kMaxGapMs / mPeriodMs)) + 1;
+}
+
+void UniformResampler::setMode(ResampleMode mode) {
+    if (mode == mMode) return;
+    mMode = mode;
+    mHave = 0;
+}
+
+void UniformResampler::reset() {
+    mHave = 0;
+    mMeanIntervalMs = 0.0;
+    mIntervalVar = 0.0;
+    mHaveStats = false;
+}
+
+float UniformResampler::getEffectiveFps() const {
+    return mMeanIntervalMs > 0.0 ? static_cast<float>(1000.0 / mMeanIntervalMs) : 0.0f;
+}
+
+float UniformResampler::getJitterMs() const {
+    return static_cast<float>(sqrt(mIntervalVar));
+}
+
+void UniformResampler::restart(double t, float v) {
+    mT[3] = t;
+    mV[3] = v;
+    mHave = 1;
+    mNextGridT = t;
+}
+
+void UniformResampler::updateStats(double intervalMs) {
+    if (!mHaveStats) {
+        mMeanIntervalMs = intervalMs;
+        mIntervalVar = 0.0;
+        mHaveStats = true;
+        return;
+    }
+    double diff = intervalMs - mMeanIntervalMs;
+    mMeanIntervalMs += kStatsAlpha * diff;
+    mIntervalVar = (1.0 - kStatsAlpha) * (mIntervalVar + kStatsAlpha * diff * diff);
+}
+
+int UniformResampler::push(int64_t timestampMs, float value, float* outValues, int64_t* outTimes) {
+    double t = static_cast<double>(timestampMs);
+    double dt = mHave > 0 ? t - mT[3] : 0.0;
+    if (dt > 0.0 && dt <= kMaxGapMs) updateStats(dt);
+
+    if (mMode == ResampleMode::Off) {
+        mT[3] = t;
+        mV[3] = value;
+        mHave = 1;
+        outValues[0] = value;
+        outTimes[0] = timestampMs;
+        return 1;
+    }
+
+    if (mHave == 0 || dt > kMaxGapMs || dt < -kMaxGapMs) {
+        // First sample, dropped stream or clock reset: start a new grid here
+        restart(t, value);
+        return 0;
+    }
+    if (dt <= 0.0) {
+        // Duplicate or out-of-order frame
+        return 0;
+    }
+
+    // Shift the history window
+    for (int i = 0; i < 3; ++i) {
+        mT[i] = mT[i + 1];
+        mV[i] = mV[i + 1];
+    }
+    mT[3] = t;
+    mV[3] = value;
+    if (mHave < 4) ++mHave;
+
+    if (mMode == ResampleMode::Cubic && mHave >= 4) {
+        return emitCubic(outValues, outTimes);
+    }
+    return emitLinear(outValues, outTimes);
+}
+
+int UniformResampler::emitLinear(float* outValues, int64_t* outTimes) {
+    // Grid points in [t2, t3)
+    const double t0 = mT[2];
+    const double h = mT[3] - t0;
+    const float v0 = mV[2];
+    const float slope = static_cast<float>((mV[3] - v0) / h);
+
+    int count = static_cast<int>(ceil((mT[3] - mNextGridT) / mPeriodMs));
+    if (count <= 0) return 0;
+
+    const double start = mNextGridT;
+    evaluateGrid(v0, slope, 0.0f, 0.0f, static_cast<float>(start - t0),
+                 static_cast<float>(mPeriodMs), count, outValues);
+    for (int k = 0; k < count; ++k) {
+        outTimes[k] = static_cast<int64_t>(start + k * mPeriodMs);
+    }
+    mNextGridT = start + count * mPeriodMs;
+    return count;
+}
+
+int UniformResampler::emitCubic(float* outValues, int64_t* outTimes) {
+    // Cubic Hermite on [t1, t2] with finite-difference tangents that respect
+    // the uneven spacing; the newest interval is only used for the tangent.
+    const double t1 = mT[1];
+    const double t2 = mT[2];
+    const double h = t2 - t1;
+
+    // The grid may still lag behind t1 right after switching from linear
+    if (mNextGridT < t1) mNextGridT = t1;
+
+    int count = static_cast<int>(ceil((t2 - mNextGridT) / mPeriodMs));
+    if (count <= 0) return 0;
+
+    const float p1 = mV[1];
+    const float p2 = mV[2];
+    const float m1 = static_cast<float>(h * (mV[2] - mV[0]) / (t2 - mT[0]));
+    const float m2 = static_cast<float>(h * (mV[3] - mV[1]) / (mT[3] - t1));
+
+    // Power-basis coefficients: p(u) = c0 + c1 u + c2 u^2 + c3 u^3, u in [0, 1)
+    const float c0 = p1;
+    const float c1 = m1;
+    const float c2 = -3.0f * p1 + 3.0f * p2 - 2.0f * m1 - m2;
+    const float c3 = 2.0f * p1 - 2.0f * p2 + m1 + m2;
+
+    const double start = mNextGridT;
+    const float uStart = static_cast<float>((start - t1) / h);
+    const float uStep = static_cast<float>(mPeriodMs / h);
+    evaluateGrid(c0, c1, c2, c3, uStart, uStep, count, outValues);
+    for (int k = 0; k < count; ++k) {
+        outTimes[k] = static_cast<int64_t>(start + k * mPeriodMs);
+    }
+    mNextGridT = start + count * mPeriodMs;
+    return count;
+}
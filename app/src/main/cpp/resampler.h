@@ -0,0 +1,64 @@
+// app/src/main/cpp/resampler.h
+#ifndef OJAS_RESAMPLER_H
+#define OJAS_RESAMPLER_H
+
+#include <cstdint>
+
+enum class ResampleMode {
+    Off = 0,     // samples are taken as uniformly spaced
+    Linear = 1,
+    Cubic = 2    // cubic Hermite, one input sample of extra latency
+};
+
+/**
+ * Incremental resampler from jittery (timestamp, value) pairs onto a uniform
+ * grid at the target rate. Each push only interpolates the grid points that
+ * fall inside the newest input interval.
+ *
+ * Also tracks the measured input frame rate and its jitter.
+ */
+class UniformResampler {
+public:
+    // Gaps longer than this restart the grid instead of being interpolated
+    static constexpr double kMaxGapMs = 1000.0;
+
+    UniformResampler(float targetRate, ResampleMode mode);
+
+    // Upper bound on the number of grid points a single push can produce
+    int maxOutputsPerPush() const;
+
+    /**
+     * Feed one input sample. Grid values and their timestamps are written to
+     * outValues / outTimes; returns how many were written.
+     */
+    int push(int64_t timestampMs, float value, float* outValues, int64_t* outTimes);
+
+    void setMode(ResampleMode mode);
+    ResampleMode getMode() const { return mMode; }
+    void reset();
+
+    float getEffectiveFps() const;
+    float getJitterMs() const;
+
+private:
+    double mPeriodMs;
+    ResampleMode mMode;
+
+    // Last four inputs, oldest first
+    double mT[4] = {0.0, 0.0, 0.0, 0.0};
+    float mV[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    int mHave = 0;
+    double mNextGridT = 0.0;
+
+    // Interval statistics (exponential moving averages)
+    double mMeanIntervalMs = 0.0;
+    double mIntervalVar = 0.0;
+    bool mHaveStats = false;
+
+    void restart(double t, float v);
+    void updateStats(double intervalMs);
+    int emitLinear(float* outValues, int64_t* outTimes);
+    int emitCubic(float* outValues, int64_t* outTimes);
+};
+
+#endif //OJAS_RESAMPLER_H
@@ -0,0 +1,82 @@
+// app/src/main/cpp/ring_buffer.h
+#ifndef OJAS_RING_BUFFER_H
+#define OJAS_RING_BUFFER_H
+
+#include <cstdlib>
+#include <new>
+
+constexpr size_t kCacheLineSize = 64;
+
+/**
+ * Fixed-capacity ring buffer with O(1) push.
+ *
+ * The backing store is mirrored: every value is written at slot i and at
+ * slot i + capacity, so the window (oldest -> newest) is always a single
+ * contiguous span. data() is therefore an unwrapped view that can be handed
+ * straight to the FFT stage without copying or re-ordering.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(int capacity)
+            : mCapacity(capacity > 0 ? capacity : 1) {
+        void* mem = nullptr;
+        if (posix_memalign(&mem, kCacheLineSize, sizeof(T) * 2 * mCapacity) != 0) {
+            throw std::bad_alloc();
+        }
+        mData = static_cast<T*>(mem);
+        mOwnsData = true;
+        for (int i = 0; i < 2 * mCapacity; ++i) mData[i] = T();
+    }
+
+    // Non-owning: `storage` must hold storageSize(capacity) elements
+    RingBuffer(int capacity, T* storage)
+            : mData(storage), mCapacity(capacity > 0 ? capacity : 1) {
+        for (int i = 0; i < 2 * mCapacity; ++i) mData[i] = T();
+    }
+
+    ~RingBuffer() {
+        if (mOwnsData) free(mData);
+    }
+
+    static size_t storageSize(int capacity) {
+        return 2 * static_cast<size_t>(capacity > 0 ? capacity : 1);
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    void push(T value) {
+        mData[mHead] = value;
+        mData[mHead + mCapacity] = value;
+        if (++mHead == mCapacity) mHead = 0;
+        if (mSize < mCapacity) ++mSize;
+    }
+
+    // Contiguous view of the window, oldest first. Valid until the next push.
+    const T* data() const {
+        return mData + mHead + mCapacity - mSize;
+    }
+
+    const T& operator[](int i) const { return data()[i]; }
+    const T& newest() const { return mData[mHead + mCapacity - 1]; }
+
+    int size() const { return mSize; }
+    int capacity() const { return mCapacity; }
+    bool empty() const { return mSize == 0; }
+    bool full() const { return mSize == mCapacity; }
+
+    void clear() {
+        mHead = 0;
+        mSize = 0;
+    }
+
+private:
+    T* mData = nullptr;
+    bool mOwnsData = false;
+    int mCapacity;
+    int mHead = 0;
+    int mSize = 0;
+};
+
+#endif //OJAS_RING_BUFFER_H
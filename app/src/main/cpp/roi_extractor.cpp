@@ -0,0 +1,566 @@
+// app/src/main/cpp/roi_extractor.cpp
+#include "roi_extractor.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#ifdef USE_NEON
+#include <arm_neon.h>
+#ifdef __aarch64__
+#include "frame_stats_dotprod.h"
+#endif
+#elif defined(USE_SSE)
+#include <immintrin.h>
+#endif
+
+struct Point {
+    float x;
+    float y;
+};
+
+static float cross(const Point& o, const Point& a, const Point& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Andrew's monotone chain; writes the hull counter-clockwise and returns its size
+static int convexHull(Point* pts, int n, Point* hull) {
+    std::sort(pts, pts + n, [](const Point& a, const Point& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    if (n < 3) {
+        std::copy(pts, pts + n, hull);
+        return n;
+    }
+    int k = 0;
+    for (int i = 0; i < n; ++i) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0.0f) --k;
+        hull[k++] = pts[i];
+    }
+    for (int i = n - 2, lower = k + 1; i >= 0; --i) {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0.0f) --k;
+        hull[k++] = pts[i];
+    }
+    return k - 1;
+}
+
+// Hull of one ROI clipped to the pixels [left, right) x [top, bottom);
+// rows [y0, y1] meet it
+struct ConvexScan {
+    Point hull[2 * kMaxRoiPoints];
+    int n;
+    int left;
+    int right;
+    int y0;
+    int y1;
+    int columns;    // clipped bounding-box width, for sizing the work
+};
+
+static bool prepareScan(Point* pts, int count, int left, int top, int right, int bottom,
+                        ConvexScan& scan) {
+    count = std::min(count, kMaxRoiPoints);
+    if (count < 3) return false;
+
+    scan.n = convexHull(pts, count, scan.hull);
+    if (scan.n < 3) return false;
+
+    float minX = scan.hull[0].x, maxX = scan.hull[0].x;
+    float minY = scan.hull[0].y, maxY = scan.hull[0].y;
+    for (int i = 1; i < scan.n; ++i) {
+        minX = std::min(minX, scan.hull[i].x);
+        maxX = std::max(maxX, scan.hull[i].x);
+        minY = std::min(minY, scan.hull[i].y);
+        maxY = std::max(maxY, scan.hull[i].y);
+    }
+
+    // Sample at pixel centres: row y covers y + 0.5, column x covers x + 0.5
+    scan.left = left;
+    scan.right = right;
+    scan.y0 = std::max(top, static_cast<int>(ceilf(minY - 0.5f)));
+    scan.y1 = std::min(bottom - 1, static_cast<int>(floorf(maxY - 0.5f)));
+    scan.columns = std::min(right - 1, static_cast<int>(floorf(maxX - 0.5f))) -
+                   std::max(left, static_cast<int>(ceilf(minX - 0.5f))) + 1;
+    return scan.y1 >= scan.y0 && scan.columns > 0;
+}
+
+// Pixel-centre span [x0, x1] of the hull on row y; false if the row misses it
+static bool rowSpan(const ConvexScan& scan, int y, int& x0, int& x1) {
+    // A convex polygon meets each scanline in one interval
+    const Point* hull = scan.hull;
+    const int n = scan.n;
+    float cy = y + 0.5f;
+    float left = INFINITY, right = -INFINITY;
+    for (int i = 0; i < n; ++i) {
+        const Point& a = hull[i];
+        const Point& b = hull[(i + 1) % n];
+        if ((a.y <= cy && b.y >= cy) || (b.y <= cy && a.y >= cy)) {
+            float x = a.y == b.y ? a.x : a.x + (cy - a.y) * (b.x - a.x) / (b.y - a.y);
+            float other = a.y == b.y ? b.x : x;
+            left = std::min(left, std::min(x, other));
+            right = std::max(right, std::max(x, other));
+        }
+    }
+    x0 = std::max(scan.left, static_cast<int>(ceilf(left - 0.5f)));
+    x1 = std::min(scan.right - 1, static_cast<int>(floorf(right - 0.5f)));
+    return x1 >= x0;
+}
+
+/**
+ * Visits the hull's rows [first, last) as one [x0, x1] span per row (pixel
+ * centres inside the hull). Returns the number of pixels visited.
+ */
+template <typename SpanFn>
+static int scanRows(const ConvexScan& scan, int first, int last, SpanFn span) {
+    int pixels = 0;
+    for (int y = first; y < last; ++y) {
+        int x0, x1;
+        if (!rowSpan(scan, y, x0, x1)) continue;
+        span(y, x0, x1);
+        pixels += x1 - x0 + 1;
+    }
+    return pixels;
+}
+
+RoiStats convexRoiStats(const PlaneView& rgba, const float* points, int count, ThreadPool* pool) {
+    RoiStats result{};
+    if (rgba.pixelStride != 4) return result;
+
+    Point pts[kMaxRoiPoints];
+    count = std::min(count, kMaxRoiPoints);
+    for (int i = 0; i < count; ++i) pts[i] = {points[2 * i], points[2 * i + 1]};
+
+    ConvexScan scan;
+    if (!prepareScan(pts, count, 0, 0, rgba.width, rgba.height, scan)) return result;
+
+    // One cache line per tile so neighbouring tiles never share one
+    struct alignas(64) Partial {
+        uint64_t sums[3];
+        uint64_t squares[3];
+        int pixels;
+    };
+    Partial partial[kMaxRowTiles] = {};
+    const int tiles = rowTileCount(pool, scan.y1 - scan.y0 + 1, scan.columns);
+    forEachRowTile(pool, tiles, scan.y0, scan.y1 + 1, [&](int tile, int first, int last) {
+        Partial& p = partial[tile];
+        p.pixels = scanRows(scan, first, last, [&](int y, int x0, int x1) {
+            accumulateRgbaSpan(rgba.data + static_cast<size_t>(y) * rgba.rowStride + x0 * 4,
+                               x1 - x0 + 1, p.sums, p.squares);
+        });
+    });
+
+    uint64_t sums[3] = {0, 0, 0};
+    uint64_t squares[3] = {0, 0, 0};
+    int pixels = 0;
+    for (int t = 0; t < tiles; ++t) {
+        for (int c = 0; c < 3; ++c) {
+            sums[c] += partial[t].sums[c];
+            squares[c] += partial[t].squares[c];
+        }
+        pixels += partial[t].pixels;
+    }
+
+    if (pixels > 0) {
+        for (int c = 0; c < 3; ++c) {
+            double mean = static_cast<double>(sums[c]) / pixels;
+            result.mean[c] = static_cast<float>(mean);
+            result.variance[c] = static_cast<float>(
+                    std::max(0.0, static_cast<double>(squares[c]) / pixels - mean * mean));
+        }
+        result.pixels = pixels;
+    }
+    return result;
+}
+
+// Raw moments of (Y, Cb, Cr) over a set of luma pixels
+struct YuvMoments {
+    uint64_t y, u, v;
+    uint64_t yy, uu, vv;
+    uint64_t yu, yv, uv;
+};
+
+static inline void addMoments(YuvMoments& m, const YuvMoments& q) {
+    m.y += q.y; m.u += q.u; m.v += q.v;
+    m.yy += q.yy; m.uu += q.uu; m.vv += q.vv;
+    m.yu += q.yu; m.yv += q.yv; m.uv += q.uv;
+}
+
+static inline bool isSkin(uint32_t l, uint32_t u, uint32_t v, const SkinThresholds& skin) {
+    // Saturating Cr - Cb, as in the vector kernels
+    uint32_t chroma = v > u ? v - u : 0;
+    return l >= skin.minY && l <= skin.maxY && u >= skin.minCb && u <= skin.maxCb &&
+           v >= skin.minCr && v <= skin.maxCr && chroma >= skin.minCrMinusCb;
+}
+
+#ifdef USE_NEON
+static inline uint32_t horizontalSum(uint32x4_t v) {
+    return vgetq_lane_u32(v, 0) + vgetq_lane_u32(v, 1) +
+           vgetq_lane_u32(v, 2) + vgetq_lane_u32(v, 3);
+}
+
+// acc += a * b over 16 byte lanes, widened through u16 products
+static inline uint32x4_t multiplyAccumulate(uint32x4_t acc, uint8x16_t a, uint8x16_t b) {
+    acc = vpadalq_u16(acc, vmull_u8(vget_low_u8(a), vget_low_u8(b)));
+    return vpadalq_u16(acc, vmull_u8(vget_high_u8(a), vget_high_u8(b)));
+}
+#elif defined(USE_SSE)
+static inline uint32_t addLanes32(__m128i v) {
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+}
+
+static inline uint32_t addLanes64(__m128i v) {
+    return static_cast<uint32_t>(_mm_cvtsi128_si64(v) + _mm_extract_epi64(v, 1));
+}
+
+// 0xFF where lo <= x <= hi (unsigned bytes)
+static inline __m128i inRange(__m128i x, __m128i lo, __m128i hi) {
+    return _mm_cmpeq_epi8(_mm_min_epu8(_mm_max_epu8(x, lo), hi), x);
+}
+
+// acc += a * b over 16 byte lanes; pmaddwd adds neighbouring products into i32
+static inline __m128i multiplyAccumulate(__m128i acc, __m128i a, __m128i b) {
+    const __m128i zero = _mm_setzero_si128();
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+    return _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+}
+#endif
+
+/**
+ * Moments of luma columns [x0, x1] of luma row y (each chroma sample covers
+ * two luma columns), restricted to the skin pixels when kSkinOnly; returns
+ * how many pixels were accumulated. Packed luma with planar or semi-planar
+ * chroma (every Android camera) takes 16 pixels per step: the 8 chroma
+ * samples are duplicated to one byte per pixel and, for skin, classified
+ * and combined with the luma test into a mask that zeroes every moment of
+ * a rejected pixel. Cores with the dot-product extension take those steps
+ * in accumulateYuvDot instead.
+ */
+template <bool kSkinOnly>
+static int accumulateYuvSpan(const YuvFrame& frame, int y, int x0, int x1,
+                             const SkinThresholds& skin, YuvMoments& m) {
+    const uint8_t* yRow = frame.y.data + static_cast<size_t>(y) * frame.y.rowStride;
+    const uint8_t* uRow = frame.u.data + static_cast<size_t>(y >> 1) * frame.u.rowStride;
+    const uint8_t* vRow = frame.v.data + static_cast<size_t>(y >> 1) * frame.v.rowStride;
+    const int yStep = frame.y.pixelStride;
+    const int uvStep = frame.u.pixelStride;
+
+    // Per-span partials fit 32 bits for any realistic width
+    uint32_t sy = 0, su = 0, sv = 0, syy = 0, suu = 0, svv = 0, syu = 0, syv = 0, suv = 0;
+    uint32_t pixels = 0;
+    auto pixel = [&](int x) {
+        uint32_t l = yRow[static_cast<size_t>(x) * yStep];
+        uint32_t u = uRow[static_cast<size_t>(x >> 1) * uvStep];
+        uint32_t v = vRow[static_cast<size_t>(x >> 1) * frame.v.pixelStride];
+        if constexpr (kSkinOnly) {
+            if (!isSkin(l, u, v, skin)) return;
+            ++pixels;
+        }
+        sy += l; su += u; sv += v;
+        syy += l * l; suu += u * u; svv += v * v;
+        syu += l * u; syv += l * v; suv += u * v;
+    };
+
+    int x = x0;
+    // Vector steps start on a chroma boundary
+    if (x & 1) pixel(x++);
+#if defined(USE_NEON) || defined(USE_SSE)
+    const bool vectorLayout = yStep == 1 && frame.v.pixelStride == uvStep && (uvStep == 1 || uvStep == 2);
+    // A semi-planar load reads one byte past its 8th sample, so it must not be the row's last
+    auto fits = [&](int at) {
+        return at + 15 <= x1 && (uvStep == 1 || (at >> 1) + 8 < frame.u.width);
+    };
+#endif
+#ifdef USE_NEON
+    if (vectorLayout && fits(x)) {
+#ifdef __aarch64__
+        if (dotProdEnabled()) {
+            // Last start fits() accepts; the loop below then has nothing left to do
+            const int limit = uvStep == 1 ? x1 - 15 : std::min(x1 - 15, 2 * frame.u.width - 17);
+            uint32_t dot[9] = {};
+            const int kept = accumulateYuvDot(yRow, uRow, vRow, uvStep, x, limit,
+                                              kSkinOnly ? &skin : nullptr, dot);
+            if constexpr (kSkinOnly) pixels += kept;
+            sy += dot[0]; su += dot[1]; sv += dot[2];
+            syy += dot[3]; suu += dot[4]; svv += dot[5];
+            syu += dot[6]; syv += dot[7]; suv += dot[8];
+        }
+#endif
+        const uint8x16_t minY = vdupq_n_u8(skin.minY), maxY = vdupq_n_u8(skin.maxY);
+        const uint8x8_t minCb = vdup_n_u8(skin.minCb), maxCb = vdup_n_u8(skin.maxCb);
+        const uint8x8_t minCr = vdup_n_u8(skin.minCr), maxCr = vdup_n_u8(skin.maxCr);
+        const uint8x8_t minChroma = vdup_n_u8(skin.minCrMinusCb);
+        uint32x4_t accY = vdupq_n_u32(0), accU = accY, accV = accY, accN = accY;
+        uint32x4_t accYY = accY, accUU = accY, accVV = accY, accYU = accY, accYV = accY, accUV = accY;
+        for (; fits(x); x += 16) {
+            uint8x16_t l = vld1q_u8(yRow + x);
+            uint8x8_t u = uvStep == 2 ? vld2_u8(uRow + x).val[0] : vld1_u8(uRow + (x >> 1));
+            uint8x8_t v = uvStep == 2 ? vld2_u8(vRow + x).val[0] : vld1_u8(vRow + (x >> 1));
+
+            uint8x8x2_t uPairs = vzip_u8(u, u);
+            uint8x8x2_t vPairs = vzip_u8(v, v);
+            uint8x16_t lm = l;
+            uint8x16_t um = vcombine_u8(uPairs.val[0], uPairs.val[1]);
+            uint8x16_t vm = vcombine_u8(vPairs.val[0], vPairs.val[1]);
+            if constexpr (kSkinOnly) {
+                uint8x8_t chroma = vand_u8(vand_u8(vcge_u8(u, minCb), vcle_u8(u, maxCb)),
+                                           vand_u8(vcge_u8(v, minCr), vcle_u8(v, maxCr)));
+                chroma = vand_u8(chroma, vcge_u8(vqsub_u8(v, u), minChroma));
+                uint8x8x2_t wide = vzip_u8(chroma, chroma);
+                uint8x16_t mask = vandq_u8(vcombine_u8(wide.val[0], wide.val[1]),
+                                           vandq_u8(vcgeq_u8(l, minY), vcleq_u8(l, maxY)));
+                lm = vandq_u8(lm, mask);
+                um = vandq_u8(um, mask);
+                vm = vandq_u8(vm, mask);
+                accN = vpadalq_u16(accN, vpaddlq_u8(vshrq_n_u8(mask, 7)));
+            }
+
+            accY = vpadalq_u16(accY, vpaddlq_u8(lm));
+            accU = vpadalq_u16(accU, vpaddlq_u8(um));
+            accV = vpadalq_u16(accV, vpaddlq_u8(vm));
+            accYY = multiplyAccumulate(accYY, lm, lm);
+            accUU = multiplyAccumulate(accUU, um, um);
+            accVV = multiplyAccumulate(accVV, vm, vm);
+            accYU = multiplyAccumulate(accYU, lm, um);
+            accYV = multiplyAccumulate(accYV, lm, vm);
+            accUV = multiplyAccumulate(accUV, um, vm);
+        }
+        pixels += horizontalSum(accN);
+        sy += horizontalSum(accY); su += horizontalSum(accU); sv += horizontalSum(accV);
+        syy += horizontalSum(accYY); suu += horizontalSum(accUU); svv += horizontalSum(accVV);
+        syu += horizontalSum(accYU); syv += horizontalSum(accYV); suv += horizontalSum(accUV);
+    }
+#elif defined(USE_SSE)
+    if (vectorLayout && fits(x)) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi8(1);
+        const __m128i lowBytes = _mm_set1_epi16(0xFF);
+        const __m128i minY = _mm_set1_epi8(static_cast<char>(skin.minY));
+        const __m128i maxY = _mm_set1_epi8(static_cast<char>(skin.maxY));
+        const __m128i minCb = _mm_set1_epi8(static_cast<char>(skin.minCb));
+        const __m128i maxCb = _mm_set1_epi8(static_cast<char>(skin.maxCb));
+        const __m128i minCr = _mm_set1_epi8(static_cast<char>(skin.minCr));
+        const __m128i maxCr = _mm_set1_epi8(static_cast<char>(skin.maxCr));
+        const __m128i minChroma = _mm_set1_epi8(static_cast<char>(skin.minCrMinusCb));
+        // Byte sums go through psadbw into u64 lanes, products through pmaddwd into i32
+        __m128i accY = zero, accU = zero, accV = zero, accN = zero;
+        __m128i accYY = zero, accUU = zero, accVV = zero, accYU = zero, accYV = zero, accUV = zero;
+        for (; fits(x); x += 16) {
+            __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow + x));
+            __m128i u, v;
+            if (uvStep == 2) {
+                __m128i uRaw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uRow + x));
+                __m128i vRaw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(vRow + x));
+                u = _mm_packus_epi16(_mm_and_si128(uRaw, lowBytes), zero);
+                v = _mm_packus_epi16(_mm_and_si128(vRaw, lowBytes), zero);
+            } else {
+                u = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(uRow + (x >> 1)));
+                v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(vRow + (x >> 1)));
+            }
+
+            __m128i lm = l;
+            __m128i um = _mm_unpacklo_epi8(u, u);
+            __m128i vm = _mm_unpacklo_epi8(v, v);
+            if constexpr (kSkinOnly) {
+                __m128i chroma = _mm_and_si128(inRange(u, minCb, maxCb), inRange(v, minCr, maxCr));
+                __m128i difference = _mm_subs_epu8(v, u);
+                chroma = _mm_and_si128(chroma, _mm_cmpeq_epi8(_mm_max_epu8(difference, minChroma), difference));
+                __m128i mask = _mm_and_si128(_mm_unpacklo_epi8(chroma, chroma), inRange(l, minY, maxY));
+                lm = _mm_and_si128(lm, mask);
+                um = _mm_and_si128(um, mask);
+                vm = _mm_and_si128(vm, mask);
+                accN = _mm_add_epi64(accN, _mm_sad_epu8(_mm_and_si128(mask, ones), zero));
+            }
+
+            accY = _mm_add_epi64(accY, _mm_sad_epu8(lm, zero));
+            accU = _mm_add_epi64(accU, _mm_sad_epu8(um, zero));
+            accV = _mm_add_epi64(accV, _mm_sad_epu8(vm, zero));
+            accYY = multiplyAccumulate(accYY, lm, lm);
+            accUU = multiplyAccumulate(accUU, um, um);
+            accVV = multiplyAccumulate(accVV, vm, vm);
+            accYU = multiplyAccumulate(accYU, lm, um);
+            accYV = multiplyAccumulate(accYV, lm, vm);
+            accUV = multiplyAccumulate(accUV, um, vm);
+        }
+        pixels += addLanes64(accN);
+        sy += addLanes64(accY); su += addLanes64(accU); sv += addLanes64(accV);
+        syy += addLanes32(accYY); suu += addLanes32(accUU); svv += addLanes32(accVV);
+        syu += addLanes32(accYU); syv += addLanes32(accYV); suv += addLanes32(accUV);
+    }
+#endif
+    for (; x <= x1; ++x) pixel(x);
+
+    m.y += sy; m.u += su; m.v += sv;
+    m.yy += syy; m.uu += suu; m.vv += svv;
+    m.yu += syu; m.yv += syv; m.uv += suv;
+    return kSkinOnly ? static_cast<int>(pixels) : x1 - x0 + 1;
+}
+
+// (Y, Cb, Cr) moments of `pixels` pixels -> R, G, B statistics
+static RoiStats statsFromMoments(const YuvMoments& m, int pixels) {
+    RoiStats result{};
+    if (pixels == 0) return result;
+
+    // Means and covariance of (Y, Cb, Cr)
+    const double n = pixels;
+    const double mean[3] = {m.y / n, m.u / n, m.v / n};
+    const double cov[3][3] = {
+            {m.yy / n - mean[0] * mean[0], m.yu / n - mean[0] * mean[1], m.yv / n - mean[0] * mean[2]},
+            {m.yu / n - mean[0] * mean[1], m.uu / n - mean[1] * mean[1], m.uv / n - mean[1] * mean[2]},
+            {m.yv / n - mean[0] * mean[2], m.uv / n - mean[1] * mean[2], m.vv / n - mean[2] * mean[2]}};
+
+    // BT.601 limited range: rgb = M * (Y - 16, Cb - 128, Cr - 128)
+    static const double M[3][3] = {
+            {1.164, 0.0, 1.596},
+            {1.164, -0.391, -0.813},
+            {1.164, 2.018, 0.0}};
+    const double centred[3] = {mean[0] - 16.0, mean[1] - 128.0, mean[2] - 128.0};
+    for (int c = 0; c < 3; ++c) {
+        double value = 0.0, variance = 0.0;
+        for (int i = 0; i < 3; ++i) {
+            value += M[c][i] * centred[i];
+            for (int j = 0; j < 3; ++j) variance += M[c][i] * M[c][j] * cov[i][j];
+        }
+        result.mean[c] = static_cast<float>(value);
+        result.variance[c] = static_cast<float>(std::max(0.0, variance));
+    }
+    result.pixels = pixels;
+    return result;
+}
+
+void convexRoiStatsYuv(const YuvFrame& frame, const float* points, const int* starts, int rois,
+                       RoiStats* out, ThreadPool* pool, const SkinThresholds* skin) {
+    const int width = frame.y.width;
+    const int height = frame.y.height;
+    rois = std::min(rois, kMaxRois);
+    for (int r = 0; r < rois; ++r) out[r] = RoiStats{};
+
+    // Only the crop rectangle holds image content
+    int cropLeft = 0, cropTop = 0, cropRight = width, cropBottom = height;
+    if (frame.cropRight > frame.cropLeft && frame.cropBottom > frame.cropTop) {
+        cropLeft = std::max(0, frame.cropLeft);
+        cropTop = std::max(0, frame.cropTop);
+        cropRight = std::min(width, frame.cropRight);
+        cropBottom = std::min(height, frame.cropBottom);
+    }
+
+    ConvexScan scans[kMaxRois];
+    bool hit[kMaxRois] = {};
+    int y0 = cropBottom, y1 = cropTop - 1, columns = 0;
+    for (int r = 0; r < rois; ++r) {
+        // Upright -> sensor coordinates (continuous, so pixel centres map to pixel centres)
+        const float* p = points + 2 * starts[r];
+        const int count = std::min(starts[r + 1] - starts[r], kMaxRoiPoints);
+        Point pts[kMaxRoiPoints];
+        for (int i = 0; i < count; ++i) {
+            float x = p[2 * i];
+            float y = p[2 * i + 1];
+            switch (frame.rotation) {
+                case 90: pts[i] = {y, height - x}; break;
+                case 180: pts[i] = {width - x, height - y}; break;
+                case 270: pts[i] = {width - y, x}; break;
+                default: pts[i] = {x, y}; break;
+            }
+        }
+        hit[r] = prepareScan(pts, count, cropLeft, cropTop, cropRight, cropBottom, scans[r]);
+        if (!hit[r]) continue;
+        y0 = std::min(y0, scans[r].y0);
+        y1 = std::max(y1, scans[r].y1);
+        columns += scans[r].columns;
+    }
+    if (y1 < y0) return;
+
+    struct alignas(64) Partial {
+        YuvMoments moments[kMaxRois];
+        int pixels[kMaxRois];
+    };
+    Partial partial[kMaxRowTiles] = {};
+    const int tiles = rowTileCount(pool, y1 - y0 + 1, columns);
+    forEachRowTile(pool, tiles, y0, y1 + 1, [&](int tile, int first, int last) {
+        Partial& p = partial[tile];
+        for (int y = first; y < last; ++y) {
+            // Every ROI's span on this row, then the row is cut at each span
+            // edge so each piece has one set of covering ROIs and is read once
+            int spanStart[kMaxRois], spanEnd[kMaxRois];
+            int edges[2 * kMaxRois];
+            int edgeCount = 0;
+            unsigned active = 0;
+            for (int r = 0; r < rois; ++r) {
+                if (!hit[r] || y < scans[r].y0 || y > scans[r].y1) continue;
+                if (!rowSpan(scans[r], y, spanStart[r], spanEnd[r])) continue;
+                active |= 1u << r;
+                edges[edgeCount++] = spanStart[r];
+                edges[edgeCount++] = spanEnd[r] + 1;
+            }
+            if (!active) continue;
+            std::sort(edges, edges + edgeCount);
+
+            for (int e = 0; e + 1 < edgeCount; ++e) {
+                const int a = edges[e], b = edges[e + 1] - 1;
+                if (b < a) continue;
+                unsigned cover = 0;
+                for (int r = 0; r < rois; ++r) {
+                    if ((active >> r & 1) && spanStart[r] <= a && b <= spanEnd[r]) cover |= 1u << r;
+                }
+                if (!cover) continue;
+
+                YuvMoments piece{};
+                const int kept = skin ? accumulateYuvSpan<true>(frame, y, a, b, *skin, piece)
+                                      : accumulateYuvSpan<false>(frame, y, a, b, SkinThresholds(), piece);
+                for (int r = 0; r < rois; ++r) {
+                    if (!(cover >> r & 1)) continue;
+                    addMoments(p.moments[r], piece);
+                    p.pixels[r] += kept;
+                }
+            }
+        }
+    });
+
+    for (int r = 0; r < rois; ++r) {
+        YuvMoments m{};
+        int pixels = 0;
+        for (int t = 0; t < tiles; ++t) {
+            addMoments(m, partial[t].moments[r]);
+            pixels += partial[t].pixels[r];
+        }
+        out[r] = statsFromMoments(m, pixels);
+    }
+}
+
+RoiStats convexRoiStatsYuv(const YuvFrame& frame, const float* points, int count, ThreadPool* pool,
+                           const SkinThresholds* skin) {
+    const int starts[2] = {0, count};
+    RoiStats result;
+    convexRoiStatsYuv(frame, points, starts, 1, &result, pool, skin);
+    return result;
+}
+
+double roiNanosPerPixel() {
+    const int width = 640, height = 480;
+    // Skin-like values, a share of them outside the box, as a face ROI holds
+    std::vector<uint8_t> luma(static_cast<size_t>(width) * height);
+    std::vector<uint8_t> chroma(static_cast<size_t>(width) * height / 2 + 1);
+    uint32_t seed = 1;
+    auto next = [&seed] { return (seed = seed * 1664525u + 1013904223u) >> 24; };
+    for (uint8_t& b : luma) b = static_cast<uint8_t>(40 + next() % 200);
+    for (uint8_t& b : chroma) b = static_cast<uint8_t>(80 + next() % 100);
+    const size_t chromaBytes = chroma.size() - 1;
+    const YuvFrame frame{{luma.data(), luma.size(), width, height, width, 1},
+                         {chroma.data() + 1, chromaBytes, width / 2, height / 2, width, 2},
+                         {chroma.data(), chromaBytes, width / 2, height / 2, width, 2},
+                         0};
+    const float w = width, h = height;
+    const float whole[] = {0, 0, w, 0, w, h, 0, h};
+    const SkinThresholds skin;
+
+    // Fastest of a few runs: the least disturbed one
+    double best = 1e300;
+    for (int run = 0; run < 5; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        RoiStats stats = convexRoiStatsYuv(frame, whole, 4, nullptr, &skin);
+        double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (stats.pixels >= 0) best = std::min(best, nanos);
+    }
+    return best / (static_cast<double>(width) * height);
+}
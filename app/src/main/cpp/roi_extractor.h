@@ -0,0 +1,113 @@
+// app/src/main/cpp/roi_extractor.h
+#ifndef OJAS_ROI_EXTRACTOR_H
+#define OJAS_ROI_EXTRACTOR_H
+
+#include "frame_stats.h"
+
+// Upper bound on the points making up one ROI polygon
+constexpr int kMaxRoiPoints = 64;
+
+// Upper bound on the ROIs measured together in one pass
+constexpr int kMaxRois = 8;
+
+// Colour statistics of one ROI; all zero when the polygon missed the frame
+struct RoiStats {
+    float mean[3];      // R, G, B
+    float variance[3];  // per-pixel variance of R, G, B
+    int pixels;
+};
+
+// Floats per ROI when packed for Java: mean R, G, B, variance R, G, B, pixel count
+constexpr int kPackedRoiStats = 7;
+
+/**
+ * YCbCr box a pixel must fall in to count as skin (Chai & Ngan's chroma
+ * ranges). maxY drops specular highlights and minY deep shadow and hair;
+ * minCrMinusCb rejects desaturated pixels such as glasses frames and glare,
+ * whose chroma sits near the grey point.
+ */
+struct SkinThresholds {
+    uint8_t minY = 40;
+    uint8_t maxY = 235;
+    uint8_t minCb = 77;
+    uint8_t maxCb = 127;
+    uint8_t minCr = 133;
+    uint8_t maxCr = 173;
+    uint8_t minCrMinusCb = 16;
+};
+
+/**
+ * YUV_420_888 frame as delivered by the camera: full-resolution Y plus
+ * half-resolution U and V planes, each with its own strides, in sensor
+ * orientation. rotation is the clockwise rotation (0/90/180/270) that makes
+ * the frame upright, i.e. ImageInfo.getRotationDegrees().
+ *
+ * Only pixels in the crop rectangle [cropLeft, cropRight) x [cropTop,
+ * cropBottom) (sensor coordinates, ImageProxy.getCropRect()) are read; an
+ * empty rectangle means the whole frame. The crop may start on an odd
+ * row or column; chroma is still addressed from the plane origin.
+ */
+struct YuvFrame {
+    PlaneView y;
+    PlaneView u;
+    PlaneView v;
+    int rotation;
+    int cropLeft = 0;
+    int cropTop = 0;
+    int cropRight = 0;
+    int cropBottom = 0;
+};
+
+/**
+ * R, G, B statistics over the convex hull of `count` points (x, y in pixel
+ * coordinates, interleaved) on an RGBA plane.
+ *
+ * The hull is scan-converted one row at a time; each row's interior is a
+ * single contiguous span whose sums and sums of squares are accumulated in
+ * one pass by the widening span kernel, so the cost is proportional to the
+ * covered pixels. Large ROIs are split into row tiles across `pool`, with
+ * one partial accumulator per tile merged in order, so the result is the
+ * same with or without it.
+ */
+RoiStats convexRoiStats(const PlaneView& rgba, const float* points, int count,
+                        ThreadPool* pool = nullptr);
+
+/**
+ * Same as convexRoiStats, read straight from the YUV planes. points are in
+ * upright pixel coordinates of the whole frame; the hull is mapped back to
+ * sensor orientation and scan-converted there, clipped to the crop, so
+ * nothing is converted or rotated per pixel.
+ *
+ * First and second moments of (Y, Cb, Cr), cross terms included, are summed
+ * per span and mapped through the BT.601 limited-range matrix used by
+ * CameraX's RGBA_8888 output. The matrix is linear, so this equals the
+ * statistics of per-pixel conversions wherever those do not clip.
+ *
+ * With `skin`, only pixels inside its YCbCr box are accumulated (and
+ * counted), classified in the same vectorized pass as the reduction, so
+ * eyebrows, hair, frames and highlights caught by the hull drop out.
+ */
+RoiStats convexRoiStatsYuv(const YuvFrame& frame, const float* points, int count,
+                           ThreadPool* pool = nullptr, const SkinThresholds* skin = nullptr);
+
+/**
+ * convexRoiStatsYuv for up to kMaxRois polygons in one pass over the frame:
+ * polygon i is points[2 * starts[i] .. 2 * starts[i + 1]), its statistics
+ * go to out[i]. Each row is read once; the polygons' spans on it are cut at
+ * every span edge, and each piece is reduced once and credited to every
+ * ROI covering it, so overlapping ROIs do not re-read their shared pixels.
+ */
+void convexRoiStatsYuv(const YuvFrame& frame, const float* points, const int* starts, int rois,
+                       RoiStats* out, ThreadPool* pool = nullptr,
+                       const SkinThresholds* skin = nullptr);
+
+/**
+ * Single-threaded cost per pixel of the skin-masked YUV ROI kernel (the
+ * heaviest per-frame reduction) on this device, timed on a synthetic
+ * 640x480 semi-planar frame: the nanosPerPixel ThreadPool::calibrate()
+ * wants for the frame pool. Takes a few milliseconds; keep it off the
+ * camera thread.
+ */
+double roiNanosPerPixel();
+
+#endif //OJAS_ROI_EXTRACTOR_H
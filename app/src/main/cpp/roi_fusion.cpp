@@ -0,0 +1,62 @@
+// app/src/main/cpp/roi_fusion.cpp
+#include "roi_fusion.h"
+#include <algorithm>
+#include <cmath>
+
+RoiFusion::RoiFusion(int channels, int bufferSize, float samplingRate, float updateSeconds)
+        : mChannels(std::max(1, channels)),
+          mUpdateFrames(std::max(1, static_cast<int>(lroundf(updateSeconds * samplingRate)))),
+          mScorer(mChannels, bufferSize, samplingRate) {
+    mArena.reset(2 * Arena::bytesFor<float>(mChannels));
+    mWeights = mArena.allocate<float>(mChannels);
+    mSteps = mArena.allocate<float>(mChannels);
+    reset();
+}
+
+void RoiFusion::reset() {
+    mScorer.reset();
+    mSinceUpdate = 0;
+    // Plain average until the first SNR estimate
+    std::fill(mWeights, mWeights + mChannels, 1.0f / mChannels);
+    std::fill(mSteps, mSteps + mChannels, 0.0f);
+}
+
+float RoiFusion::addFrame(const float* values) {
+    mScorer.addFrame(values);
+    if (++mSinceUpdate >= mUpdateFrames) {
+        mSinceUpdate = 0;
+        updateWeights();
+    }
+    float fused = 0.0f;
+    for (int c = 0; c < mChannels; ++c) {
+        fused += mWeights[c] * values[c];
+        mWeights[c] += mSteps[c];
+    }
+    return fused;
+}
+
+void RoiFusion::updateWeights() {
+    mScorer.computeHeartRates();
+    const float* snr = mScorer.getSnr();
+    const float* power = mScorer.getBandPower();
+
+    float total = 0.0f;
+    float amplitude = 0.0f;
+    for (int c = 0; c < mChannels; ++c) {
+        total += snr[c];
+        amplitude += sqrtf(power[c]);
+    }
+    // No ROI has an estimate yet (window filling, or a blank trace): hold
+    if (total <= 0.0f) {
+        std::fill(mSteps, mSteps + mChannels, 0.0f);
+        return;
+    }
+
+    // Scaled so the fused in-band amplitude matches a plain average's, then
+    // approached over one update period
+    amplitude /= mChannels;
+    for (int c = 0; c < mChannels; ++c) {
+        float target = power[c] > 0.0f ? snr[c] * amplitude / (total * sqrtf(power[c])) : 0.0f;
+        mSteps[c] = (target - mWeights[c]) / mUpdateFrames;
+    }
+}
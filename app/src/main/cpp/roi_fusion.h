@@ -0,0 +1,48 @@
+// app/src/main/cpp/roi_fusion.h
+#ifndef OJAS_ROI_FUSION_H
+#define OJAS_ROI_FUSION_H
+
+#include "arena.h"
+#include "multi_channel_processor.h"
+
+/**
+ * Fuses K per-ROI pulse traces (e.g. PosProcessor lanes for forehead and
+ * cheeks) into one trace for SignalProcessor, weighting each ROI by its
+ * in-band SNR so a shadowed or moving ROI no longer pollutes the rest.
+ *
+ * The traces are kept in a K-channel MultiChannelProcessor; once per update
+ * period its batched HR-band DFT gives every ROI's SNR and in-band power in
+ * one pass. ROI c's weight is SNR_c / sqrt(band power_c): each trace is
+ * brought to unit in-band amplitude, then scaled by its SNR. Weights ramp to
+ * each new estimate over the following update period, so the fused trace
+ * never steps.
+ */
+class RoiFusion {
+public:
+    RoiFusion(int channels, int bufferSize, float samplingRate, float updateSeconds = 1.0f);
+
+    // values[c] is ROI c's sample for this frame; returns the fused sample
+    float addFrame(const float* values);
+
+    // Current weights and the SNRs they came from; valid until the next addFrame()
+    const float* getWeights() const { return mWeights; }
+    const float* getSnr() const { return mScorer.getSnr(); }
+
+    int getChannelCount() const { return mChannels; }
+    void reset();
+
+private:
+    int mChannels;
+    int mUpdateFrames;
+    int mSinceUpdate = 0;
+
+    MultiChannelProcessor mScorer;
+
+    Arena mArena;
+    float* mWeights;
+    float* mSteps;      // per-frame weight change towards the latest estimate
+
+    void updateWeights();
+};
+
+#endif //OJAS_ROI_FUSION_H
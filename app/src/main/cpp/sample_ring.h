@@ -0,0 +1,108 @@
+// app/src/main/cpp/sample_ring.h
+#ifndef OJAS_SAMPLE_RING_H
+#define OJAS_SAMPLE_RING_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Single-producer / single-consumer queue of (value, timestamp) records in
+ * memory shared with Kotlin (a direct ByteBuffer, see core/SampleRing.kt),
+ * so samples reach native code without a JNI call each.
+ *
+ * Layout, native byte order:
+ *   [0]    int32 write index  - written by the producer only (release)
+ *   [64]   int32 read index   - written by the consumer only (release)
+ *   [68]   int32 window size after the consumer's last drain
+ *   [128]  capacity records of 16 bytes: int64 timestamp, float value, pad
+ * Indices run freely (wrapping at 2^32) and are masked by capacity - 1;
+ * the two index words sit on separate cache lines.
+ */
+class SampleRing {
+public:
+    static constexpr size_t kWriteOffset = 0;
+    static constexpr size_t kReadOffset = 64;
+    static constexpr size_t kCountOffset = 68;
+    static constexpr size_t kHeaderBytes = 128;
+    static constexpr size_t kRecordBytes = 16;
+
+    // Uses the largest power-of-two record count that fits; false if the
+    // block is too small or not 8-byte aligned
+    bool attach(uint8_t* memory, size_t bytes) {
+        detach();
+        if (!memory || bytes < kHeaderBytes + kRecordBytes ||
+            reinterpret_cast<uintptr_t>(memory) % 8 != 0) {
+            return false;
+        }
+        uint32_t capacity = 1;
+        while ((capacity << 1) <= (bytes - kHeaderBytes) / kRecordBytes) capacity <<= 1;
+        mMemory = memory;
+        mMask = capacity - 1;
+        return true;
+    }
+
+    void detach() {
+        mMemory = nullptr;
+        mMask = 0;
+    }
+
+    bool attached() const { return mMemory != nullptr; }
+
+    // Hands every published record to fn(value, timestamp), oldest first,
+    // then frees their slots. Returns the number drained.
+    template <typename Fn>
+    int drain(Fn fn) {
+        if (!mMemory) return 0;
+        uint32_t read = load(kReadOffset, __ATOMIC_RELAXED);
+        uint32_t write = load(kWriteOffset, __ATOMIC_ACQUIRE);
+        int count = static_cast<int>(write - read);
+        for (; read != write; ++read) {
+            const uint8_t* record = mMemory + kHeaderBytes + (read & mMask) * kRecordBytes;
+            int64_t timestamp;
+            float value;
+            memcpy(&timestamp, record, sizeof(timestamp));
+            memcpy(&value, record + 8, sizeof(value));
+            fn(value, timestamp);
+        }
+        store(kReadOffset, write, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    // Producer side, for rings filled from native code. False if full.
+    bool offer(float value, int64_t timestamp) {
+        if (!mMemory) return false;
+        uint32_t write = load(kWriteOffset, __ATOMIC_RELAXED);
+        uint32_t read = load(kReadOffset, __ATOMIC_ACQUIRE);
+        if (write - read > mMask) return false;
+        uint8_t* record = mMemory + kHeaderBytes + (write & mMask) * kRecordBytes;
+        memcpy(record, &timestamp, sizeof(timestamp));
+        memcpy(record + 8, &value, sizeof(value));
+        store(kWriteOffset, write + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Drops everything published so far
+    void discard() {
+        if (!mMemory) return;
+        store(kReadOffset, load(kWriteOffset, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+    }
+
+    // Lets the producer report the window size without asking over JNI
+    void publishCount(int count) {
+        if (mMemory) store(kCountOffset, static_cast<uint32_t>(count), __ATOMIC_RELAXED);
+    }
+
+private:
+    uint8_t* mMemory = nullptr;
+    uint32_t mMask = 0;
+
+    uint32_t load(size_t offset, int order) const {
+        return __atomic_load_n(reinterpret_cast<uint32_t*>(mMemory + offset), order);
+    }
+
+    void store(size_t offset, uint32_t value, int order) {
+        __atomic_store_n(reinterpret_cast<uint32_t*>(mMemory + offset), value, order);
+    }
+};
+
+#endif //OJAS_SAMPLE_RING_H
@@ -0,0 +1,59 @@
+// app/src/main/cpp/seqlock.h
+#ifndef OJAS_SEQLOCK_H
+#define OJAS_SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Single-writer sequence lock around a small trivially copyable value.
+ *
+ * The writer never waits; readers retry if a store overlapped their copy.
+ * The value is held as atomic words, so a torn copy is discarded rather than
+ * being a data race. Words are stored with release and loaded with acquire:
+ * a reader that sees any word of a newer store also sees its odd sequence,
+ * which orders the copy without standalone fences (which ThreadSanitizer
+ * cannot check).
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock needs a trivially copyable type");
+    static constexpr size_t kWords = (sizeof(T) + 3) / 4;
+
+public:
+    SeqLock() {
+        T empty{};
+        store(empty);
+    }
+
+    // Only one thread may store
+    void store(const T& value) {
+        uint32_t words[kWords] = {};
+        memcpy(words, &value, sizeof(T));
+        uint32_t seq = mSequence.load(std::memory_order_relaxed);
+        mSequence.store(seq + 1, std::memory_order_relaxed);
+        for (size_t i = 0; i < kWords; ++i) mWords[i].store(words[i], std::memory_order_release);
+        mSequence.store(seq + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        uint32_t words[kWords];
+        for (;;) {
+            uint32_t before = mSequence.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            for (size_t i = 0; i < kWords; ++i) words[i] = mWords[i].load(std::memory_order_acquire);
+            if (mSequence.load(std::memory_order_relaxed) == before) break;
+        }
+        T value;
+        memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    std::atomic<uint32_t> mSequence{0};
+    std::atomic<uint32_t> mWords[kWords];
+};
+
+#endif //OJAS_SEQLOCK_H
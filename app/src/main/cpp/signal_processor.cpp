@@ -1,106 +1,395 @@
 // app/src/main/cpp/signal_processor.cpp
 #include "signal_processor.h"
-#include <numeric>
 #include <algorithm>
-#include <android/log.h>
 
-#define LOG_TAG "ojas-Proc"
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+// Valid heart-rate band (45 - 200 BPM)
+static constexpr float kMinHrHz = 0.75f;
+static constexpr float kMaxHrHz = 3.33f;
 
-SignalProcessor::SignalProcessor(int bufferSize, float samplingRate)
-        : mBufferSize(bufferSize), mSamplingRate(samplingRate) {
+// Valid respiration band (6 - 30 breaths/min)
+static constexpr float kMinRespHz = 0.1f;
+static constexpr float kMaxRespHz = 0.5f;
+static constexpr float kRespTargetRateHz = 3.0f;   // decimated rate, Nyquist well above the band
+static constexpr float kRespHistorySec = 60.0f;
+static constexpr float kRespMinHistorySec = 30.0f;
+
+// The real-input FFT needs an even length, so odd windows grow by one sample
+static int evenLength(int n) {
+    return n + (n & 1);
+}
 
-    mRawBuffer.reserve(bufferSize);
-    mTimeBuffer.reserve(bufferSize);
+// Multitaper settings: NW = 1.5 -> 2NW - 1 = 2 tapers; wider NW flattens the HR peak too much
+static constexpr float kMultitaperNw = 1.5f;
+static constexpr int kMultitaperTapers = 2;
 
-    // Initialize KissFFT
-    mFftCfg = kiss_fft_alloc(bufferSize, 0, nullptr, nullptr);
-    mFftIn.resize(bufferSize);
-    mFftOut.resize(bufferSize);
+static int zoomPoints(float bpmStep) {
+    return static_cast<int>((kMaxHrHz - kMinHrHz) * 60.0f / bpmStep) + 1;
+}
+
+// Mean of the newest n of `count` samples; the running sum covers all of them
+static float newestMean(const float* samples, int count, int n, double runningSum) {
+    if (n == count) return static_cast<float>(runningSum / n);
+    double sum = 0.0;
+    for (int i = count - n; i < count; ++i) sum += samples[i];
+    return static_cast<float>(sum / n);
+}
+
+SignalProcessor::SignalProcessor(int bufferSize, float samplingRate)
+        : mBufferSize(evenLength(bufferSize)), mSamplingRate(samplingRate),
+          mFftLength(mBufferSize), mResampler(samplingRate, ResampleMode::Linear) {
+    allocateResources();
+    allocateRespiration();
+    mWaveform.reset(new WaveformSnapshot(mBufferSize));
 }
 
 SignalProcessor::~SignalProcessor() {
-    free(mFftCfg);
+    stopWorker();
 }
 
-void SignalProcessor::addSample(float greenValue, long timestamp) {
-    if (mRawBuffer.size() >= mBufferSize) {
-        mRawBuffer.erase(mRawBuffer.begin());
-        mTimeBuffer.erase(mTimeBuffer.begin());
+void SignalProcessor::startWorker(int intervalMs) {
+    std::unique_lock<std::shared_mutex> exclusive(mWorkerLock);
+    if (mWorker) {
+        mWorker->setInterval(intervalMs);
+    } else {
+        mWorker.reset(new AnalysisWorker(*this, intervalMs));
     }
-    mRawBuffer.push_back(greenValue);
-    mTimeBuffer.push_back(timestamp);
 }
 
-void SignalProcessor::reset() {
-    mRawBuffer.clear();
-    mTimeBuffer.clear();
-    mPrevHR = 0.0f;
+void SignalProcessor::stopWorker() {
+    std::unique_lock<std::shared_mutex> exclusive(mWorkerLock);
+    mWorker.reset();
 }
 
-const std::vector<float>& SignalProcessor::getBuffer() const {
-    return mRawBuffer;
+WorkerRef SignalProcessor::worker() const {
+    WorkerRef ref;
+    ref.mAlive = std::shared_lock<std::shared_mutex>(mWorkerLock);
+    ref.mWorker = mWorker.get();
+    return ref;
 }
 
-int SignalProcessor::getSampleCount() const {
-    return mRawBuffer.size();
+WorkerRef SignalProcessor::pauseWorker() const {
+    WorkerRef ref = worker();
+    if (ref) ref.mPause = ref->pause();
+    return ref;
 }
 
-void SignalProcessor::normalizeBuffer(const std::vector<float>& input, std::vector<float>& output) {
-    output = input;
-    if (input.empty()) return;
+void SignalProcessor::allocateResources() {
+    const int firstBin = static_cast<int>(floorf(kMinHrHz * mBufferSize / mSamplingRate));
+    const int lastBin = static_cast<int>(ceilf(kMaxHrHz * mBufferSize / mSamplingRate));
+    const int points = zoomPoints(mZoomStepBpm);
+    const int resampleMax = mResampler.maxOutputsPerPush();
+    const int magnitudeMax = std::max(mFftLength / 2 + 1, points);
+    const int minLength = minAnalysisLength();
+
+    size_t fftPlanBytes = 0;
+    kiss_fftr_alloc(mFftLength, 0, nullptr, &fftPlanBytes);
 
-    float sum = std::accumulate(input.begin(), input.end(), 0.0f);
-    float mean = sum / input.size();
+    // 1. Size the arena for everything the analysis path touches
+    size_t bytes = Arena::bytesFor<float>(RingBuffer<float>::storageSize(mBufferSize)) +
+                   Arena::bytesFor<int64_t>(RingBuffer<int64_t>::storageSize(mBufferSize)) +
+                   Arena::bytesFor<float>(resampleMax) +
+                   Arena::bytesFor<int64_t>(resampleMax) +
+                   Arena::bytesFor<char>(fftPlanBytes) +
+                   Arena::bytesFor<float>(mFftLength) +
+                   Arena::bytesFor<kiss_fft_cpx>(mFftLength / 2 + 1) +
+                   Arena::bytesFor<float>(magnitudeMax) +
+                   WindowTables::arenaBytes(minLength, mBufferSize) +
+                   SlidingDft::arenaBytes(mBufferSize, firstBin, lastBin) +
+                   ChirpZ::arenaBytes(mBufferSize, points) +
+                   WelchEstimator::arenaBytes(mBufferSize / 2, minLength) +
+                   MultitaperEstimator::arenaBytes(mBufferSize, minLength, kMultitaperTapers);
 
-    for (float &val : output) {
-        val -= mean;
+    // 2. Keep the current window across a rebuild
+    std::vector<float> keptSamples;
+    std::vector<int64_t> keptTimes;
+    if (mRawBuffer) {
+        keptSamples.assign(mRawBuffer->data(), mRawBuffer->data() + mRawBuffer->size());
+        keptTimes.assign(mTimeBuffer->data(), mTimeBuffer->data() + mTimeBuffer->size());
     }
+    mRawBuffer.reset();
+    mTimeBuffer.reset();
+    mWindows.reset();
+    mSlidingDft.reset();
+    mChirpZ.reset();
+    mWelch.reset();
+    mMultitaper.reset();
+    mArena.reset(bytes);
+
+    // 3. Lay everything out
+    mRawBuffer.reset(new RingBuffer<float>(
+            mBufferSize, mArena.allocate<float>(RingBuffer<float>::storageSize(mBufferSize))));
+    mTimeBuffer.reset(new RingBuffer<int64_t>(
+            mBufferSize, mArena.allocate<int64_t>(RingBuffer<int64_t>::storageSize(mBufferSize))));
+    mResampledValues = mArena.allocate<float>(resampleMax);
+    mResampledTimes = mArena.allocate<int64_t>(resampleMax);
+
+    mFftCfg = kiss_fftr_alloc(mFftLength, 0, mArena.allocate<char>(fftPlanBytes), &fftPlanBytes);
+    mFftIn = mArena.allocate<float>(mFftLength);
+    mFftOut = mArena.allocate<kiss_fft_cpx>(mFftLength / 2 + 1);
+    mMagnitude = mArena.allocate<float>(magnitudeMax);
+    mMagnitudeCount = 0;
+
+    mWindows.reset(new WindowTables(minLength, mBufferSize, mArena));
+    mWindows->fill(mWindowType);
+    mSlidingDft.reset(new SlidingDft(mBufferSize, firstBin, lastBin, mArena));
+    mChirpZ.reset(new ChirpZ(mBufferSize, points, kMinHrHz, mZoomStepBpm / 60.0f,
+                             mSamplingRate, mArena));
+    mWelch.reset(new WelchEstimator(mBufferSize / 2, minLength, mWelchOverlap, mArena));
+    mMultitaper.reset(new MultitaperEstimator(mBufferSize, minLength, kMultitaperNw,
+                                              kMultitaperTapers, mArena));
+
+    // 4. Restore the window and the state derived from it
+    mRunningSum = 0.0;
+    for (size_t i = 0; i < keptSamples.size(); ++i) {
+        mRawBuffer->push(keptSamples[i]);
+        mTimeBuffer->push(keptTimes[i]);
+        mRunningSum += keptSamples[i];
+    }
+    mSlidingDft->resync(mRawBuffer->data(), mRawBuffer->size());
+}
+
+void SignalProcessor::allocateRespiration() {
+    const int factor = std::max(1, static_cast<int>(lroundf(mSamplingRate / kRespTargetRateHz)));
+    const int taps = 8 * factor + 1;
+    mRespRate = mSamplingRate / factor;
+    const int capacity = static_cast<int>(ceilf(kRespHistorySec * mRespRate));
+    const int minLength = static_cast<int>(ceilf(kRespMinHistorySec * mRespRate));
+
+    // Pad to at least twice the window so the peak has a few bins to interpolate across
+    mRespFftLength = 2;
+    while (mRespFftLength < 2 * capacity) mRespFftLength <<= 1;
+
+    size_t fftPlanBytes = 0;
+    kiss_fftr_alloc(mRespFftLength, 0, nullptr, &fftPlanBytes);
+
+    mRespArena.reset(FirDecimator::arenaBytes(taps) +
+                     Arena::bytesFor<float>(RingBuffer<float>::storageSize(capacity)) +
+                     Arena::bytesFor<char>(fftPlanBytes) +
+                     Arena::bytesFor<float>(mRespFftLength) +
+                     Arena::bytesFor<kiss_fft_cpx>(mRespFftLength / 2 + 1) +
+                     WindowTables::arenaBytes(minLength, capacity));
+
+    mDecimator.reset(new FirDecimator(factor, taps, mRespArena));
+    mRespBuffer.reset(new RingBuffer<float>(
+            capacity, mRespArena.allocate<float>(RingBuffer<float>::storageSize(capacity))));
+    mRespFftCfg = kiss_fftr_alloc(mRespFftLength, 0, mRespArena.allocate<char>(fftPlanBytes),
+                                  &fftPlanBytes);
+    mRespFftIn = mRespArena.allocate<float>(mRespFftLength);
+    mRespFftOut = mRespArena.allocate<kiss_fft_cpx>(mRespFftLength / 2 + 1);
+    mRespWindows.reset(new WindowTables(minLength, capacity, mRespArena));
+    mRespWindows->fill(WindowType::Hann);
 }
 
-void SignalProcessor::applyWindow(std::vector<float>& data) {
-    size_t N = data.size();
-    for (size_t i = 0; i < N; ++i) {
-        // Hamming window
-        float multiplier = 0.54f - 0.46f * cosf((2.0f * M_PI * i) / (N - 1));
-        data[i] *= multiplier;
+void SignalProcessor::addSample(float greenValue, int64_t timestamp) {
+    int count = mResampler.push(timestamp, greenValue, mResampledValues, mResampledTimes);
+    for (int i = 0; i < count; ++i) {
+        pushUniformSample(mResampledValues[i], mResampledTimes[i]);
     }
 }
 
+void SignalProcessor::addSamples(const float* values, const int64_t* timestamps, int count) {
+    for (int i = 0; i < count; ++i) {
+        addSample(values[i], timestamps[i]);
+    }
+}
+
+int SignalProcessor::drainInput() {
+    if (!mInput.attached()) return 0;
+    int drained = mInput.drain([this](float value, int64_t timestamp) {
+        addSample(value, timestamp);
+    });
+    mInput.publishCount(getSampleCount());
+    return drained;
+}
+
+void SignalProcessor::pushUniformSample(float greenValue, int64_t timestamp) {
+    float oldest = mRawBuffer->full() ? (*mRawBuffer)[0] : 0.0f;
+    if (mEngine == SpectralEngine::SlidingDft) {
+        mSlidingDft->push(greenValue, oldest);
+    }
+    mRunningSum += static_cast<double>(greenValue) - oldest;
+    mRawBuffer->push(greenValue);
+    mTimeBuffer->push(timestamp);
+    mWaveformDirty = true;
+
+    float decimated;
+    if (mRespEnabled && mDecimator->push(greenValue, &decimated)) {
+        mRespBuffer->push(decimated);
+    }
+}
+
+void SignalProcessor::reset() {
+    // Samples queued before the reset belong to the old trace
+    mInput.discard();
+    mInput.publishCount(0);
+    mRawBuffer->clear();
+    mTimeBuffer->clear();
+    mSlidingDft->reset();
+    mResampler.reset();
+    mDecimator->reset();
+    mRespBuffer->clear();
+    mRunningSum = 0.0;
+    mPrevHR = 0.0f;
+    mPrevRR = 0.0f;
+    mPeakToNoise = 0.0f;
+    mWaveformDirty = true;
+    if (mWorker) mWorker->onReset();
+}
+
+void SignalProcessor::setSpectralEngine(SpectralEngine engine) {
+    if (engine == mEngine) return;
+    mEngine = engine;
+    if (mEngine == SpectralEngine::SlidingDft) {
+        mSlidingDft->resync(mRawBuffer->data(), mRawBuffer->size());
+    }
+}
+
+void SignalProcessor::setWindowType(WindowType type) {
+    if (type == mWindowType) return;
+    mWindowType = type;
+    mWindows->fill(mWindowType);
+}
+
+void SignalProcessor::setFftLength(int length) {
+    length = std::max(evenLength(length), mBufferSize);
+    if (length == mFftLength) return;
+    mFftLength = length;
+    allocateResources();
+}
+
+void SignalProcessor::setZoomResolution(float bpmStep) {
+    if (bpmStep <= 0.0f || bpmStep == mZoomStepBpm) return;
+    mZoomStepBpm = bpmStep;
+    allocateResources();
+}
+
+void SignalProcessor::setWelchOverlap(float overlap) {
+    mWelchOverlap = overlap;
+    mWelch->setOverlap(overlap);
+}
+
+const float* SignalProcessor::getBuffer() const {
+    return mRawBuffer->data();
+}
+
+int SignalProcessor::getSampleCount() const {
+    return mRawBuffer->size();
+}
+
+void SignalProcessor::publishWaveform() {
+    if (!mWaveformDirty) return;
+    mWaveform->publish(mRawBuffer->data(), mRawBuffer->size());
+    mWaveformDirty = false;
+}
+
+int SignalProcessor::minAnalysisLength() const {
+    return std::min(mBufferSize, static_cast<int>(ceilf(mSamplingRate * 3)));
+}
+
 float SignalProcessor::computeHeartRate() {
-    int N = mRawBuffer.size();
-    if (N < mSamplingRate * 3) {
+    int count = mRawBuffer->size();
+    if (count < mSamplingRate * 3) {
+        mPeakToNoise = 0.0f;
         return 0.0f;
     }
 
-    // 1. Prepare data
-    std::vector<float> processed;
-    normalizeBuffer(mRawBuffer, processed);
-    applyWindow(processed);
+    // While the buffer fills, analyse the newest samples that a window table fits
+    const int N = mWindows->length(count);
+    const float* samples = mRawBuffer->data() + count - N;
+    const float mean = newestMean(mRawBuffer->data(), count, N, mRunningSum);
 
-    // 2. Fill FFT input
-    for (int i = 0; i < N; ++i) {
-        mFftIn[i].r = processed[i];
-        mFftIn[i].i = 0.0f;
+    switch (mEngine) {
+        case SpectralEngine::SlidingDft: computeSlidingSpectrum(); break;
+        case SpectralEngine::ZoomFft: computeZoomSpectrum(samples, N, mean); break;
+        case SpectralEngine::Welch: computeAveragedSpectrum(*mWelch, samples, N, mean); break;
+        case SpectralEngine::Multitaper:
+            computeAveragedSpectrum(*mMultitaper, samples, N, mean);
+            break;
+        default: computeBatchSpectrum(samples, N, mean); break;
     }
-    for (int i = N; i < mBufferSize; ++i) {
-        mFftIn[i].r = 0.0f;
-        mFftIn[i].i = 0.0f;
+    return trackPeak();
+}
+
+void SignalProcessor::prepareWindowed(const float* samples, int N, float mean) {
+    // Remove mean and apply the window straight into the FFT input
+    removeMeanAndWindow(samples, mWindows->get(N), mean, N, mFftIn);
+}
+
+void SignalProcessor::computeBatchSpectrum(const float* samples, int N, float mean) {
+    // 1. Windowed input, zero-padded to the FFT length
+    prepareWindowed(samples, N, mean);
+    std::fill(mFftIn + N, mFftIn + mFftLength, 0.0f);
+
+    // 2. Execute real-input FFT (Using KissFFT)
+    kiss_fftr(mFftCfg, mFftIn, mFftOut);
+
+    mMagnitudeCount = mFftLength / 2 + 1;
+    for (int i = 0; i < mMagnitudeCount; ++i) {
+        mMagnitude[i] = sqrtf(mFftOut[i].r * mFftOut[i].r + mFftOut[i].i * mFftOut[i].i);
+    }
+    mSpectrumStartHz = 0.0f;
+    mSpectrumStepHz = mSamplingRate / mFftLength;
+}
+
+void SignalProcessor::computeZoomSpectrum(const float* samples, int N, float mean) {
+    prepareWindowed(samples, N, mean);
+    mMagnitudeCount = mChirpZ->points();
+    mChirpZ->magnitudes(mFftIn, N, mMagnitude);
+    mSpectrumStartHz = mChirpZ->startHz();
+    mSpectrumStepHz = mChirpZ->stepHz();
+}
+
+void SignalProcessor::computeAveragedSpectrum(PsdEstimator& estimator, const float* samples,
+                                              int N, float mean) {
+    mMagnitudeCount = estimator.bins();
+    estimator.estimate(samples, N, mean, mMagnitude);
+    mSpectrumStartHz = 0.0f;
+    mSpectrumStepHz = mSamplingRate / estimator.transformLength();
+}
+
+void SignalProcessor::computeSlidingSpectrum() {
+    // Bound the drift of the recursive update by recomputing once per window
+    if (mSlidingDft->needsResync()) {
+        mSlidingDft->resync(mRawBuffer->data(), mRawBuffer->size());
     }
+    mMagnitudeCount = mSlidingDft->lastBin() - mSlidingDft->firstBin() + 1;
+    mSlidingDft->magnitudes(mMagnitude);
+    mSpectrumStepHz = mSamplingRate / mBufferSize;
+    mSpectrumStartHz = mSlidingDft->firstBin() * mSpectrumStepHz;
+}
 
-    // 3. Execute FFT (Using KissFFT)
-    kiss_fft(mFftCfg, mFftIn.data(), mFftOut.data());
+float SignalProcessor::interpolatePeak(int peakIndex) const {
+    if (mPeakInterpolation == PeakInterpolation::None ||
+        peakIndex <= 0 || peakIndex + 1 >= mMagnitudeCount) {
+        return 0.0f;
+    }
 
+    float a = mMagnitude[peakIndex - 1];
+    float b = mMagnitude[peakIndex];
+    float c = mMagnitude[peakIndex + 1];
+    if (mPeakInterpolation == PeakInterpolation::Gaussian) {
+        if (a <= 0.0f || b <= 0.0f || c <= 0.0f) return 0.0f;
+        a = logf(a);
+        b = logf(b);
+        c = logf(c);
+    }
+
+    float denom = a - 2.0f * b + c;
+    if (denom >= 0.0f) return 0.0f;
+    return std::max(-0.5f, std::min(0.5f, 0.5f * (a - c) / denom));
+}
+
+float SignalProcessor::trackPeak() {
     // 4. Define Search Range (45 - 200 BPM)
-    float minFreq = 0.75f;
-    float maxFreq = 3.33f;
+    float minFreq = kMinHrHz;
+    float maxFreq = kMaxHrHz;
 
     // Smart Search: Narrow window if we have a previous lock
     if (mPrevHR > 0.0f) {
         float prevFreq = mPrevHR / 60.0f;
         float window = 15.0f / 60.0f; // +/- 15 BPM
-        minFreq = std::max(0.75f, prevFreq - window);
-        maxFreq = std::min(3.33f, prevFreq + window);
+        minFreq = std::max(kMinHrHz, prevFreq - window);
+        maxFreq = std::min(kMaxHrHz, prevFreq + window);
     }
 
     // 5. Find Peak
@@ -109,12 +398,12 @@ float SignalProcessor::computeHeartRate() {
     float sumMagnitude = 0.0f;
     int countMagnitude = 0;
 
-    for (int i = 1; i < mBufferSize / 2; ++i) {
-        float freq = (i * mSamplingRate) / mBufferSize;
-        float magnitude = sqrtf(mFftOut[i].r * mFftOut[i].r + mFftOut[i].i * mFftOut[i].i);
+    for (int i = 0; i < mMagnitudeCount; ++i) {
+        float freq = mSpectrumStartHz + i * mSpectrumStepHz;
+        float magnitude = mMagnitude[i];
 
         // Calculate average noise in valid range
-        if (freq >= 0.75f && freq <= 3.33f) {
+        if (freq >= kMinHrHz && freq <= kMaxHrHz) {
             sumMagnitude += magnitude;
             countMagnitude++;
         }
@@ -129,17 +418,19 @@ float SignalProcessor::computeHeartRate() {
     }
 
     // 6. Validate Signal Quality (SNR)
+    mPeakToNoise = 0.0f;
     if (countMagnitude > 0) {
         float avgMagnitude = sumMagnitude / countMagnitude;
+        if (avgMagnitude > 0.0f) mPeakToNoise = maxMagnitude / avgMagnitude;
         // Peak must be at least 2x the average noise
         if (maxMagnitude < avgMagnitude * 2.0f) {
             return mPrevHR > 0 ? mPrevHR : 0.0f;
         }
     }
 
-    // 7. Convert to BPM
+    // 7. Convert to BPM, refining the peak between grid points
     if (peakIndex != -1) {
-        float freq = (peakIndex * mSamplingRate) / mBufferSize;
+        float freq = mSpectrumStartHz + (peakIndex + interpolatePeak(peakIndex)) * mSpectrumStepHz;
         float currentBpm = freq * 60.0f;
 
         // Smooth update (Exponential Moving Average)
@@ -152,4 +443,70 @@ float SignalProcessor::computeHeartRate() {
     }
 
     return mPrevHR;
-}
\ No newline at end of file
+}
+
+void SignalProcessor::setRespirationEnabled(bool enabled) {
+    if (enabled == mRespEnabled) return;
+    mRespEnabled = enabled;
+    mDecimator->reset();
+    mRespBuffer->clear();
+    mPrevRR = 0.0f;
+}
+
+float SignalProcessor::computeRespirationRate() {
+    int history = mRespBuffer->size();
+    if (!mRespEnabled || history < kRespMinHistorySec * mRespRate) {
+        return 0.0f;
+    }
+
+    // 1. Mean-removed, Hann-windowed decimated trace (the newest samples a
+    //    window table fits), zero-padded
+    const int N = mRespWindows->length(history);
+    const float* samples = mRespBuffer->data() + history - N;
+    float sum = 0.0f;
+    for (int i = 0; i < N; ++i) sum += samples[i];
+    removeMeanAndWindow(samples, mRespWindows->get(N), sum / N, N, mRespFftIn);
+    std::fill(mRespFftIn + N, mRespFftIn + mRespFftLength, 0.0f);
+
+    kiss_fftr(mRespFftCfg, mRespFftIn, mRespFftOut);
+
+    // 2. Peak in the respiration band
+    const float step = mRespRate / mRespFftLength;
+    const int first = std::max(1, static_cast<int>(ceilf(kMinRespHz / step)));
+    const int last = std::min(mRespFftLength / 2 - 1, static_cast<int>(floorf(kMaxRespHz / step)));
+    auto power = [this](int k) {
+        return mRespFftOut[k].r * mRespFftOut[k].r + mRespFftOut[k].i * mRespFftOut[k].i;
+    };
+
+    float maxMagnitude = 0.0f;
+    float sumMagnitude = 0.0f;
+    int peakIndex = -1;
+    for (int k = first; k <= last; ++k) {
+        float magnitude = sqrtf(power(k));
+        sumMagnitude += magnitude;
+        if (magnitude > maxMagnitude) {
+            maxMagnitude = magnitude;
+            peakIndex = k;
+        }
+    }
+
+    // 3. Same quality gate as the HR path: peak at least 2x the band average
+    int count = last - first + 1;
+    if (peakIndex == -1 || count <= 0 || maxMagnitude < 2.0f * sumMagnitude / count) {
+        return mPrevRR;
+    }
+
+    // 4. Parabolic refinement on the magnitudes, then smooth
+    float a = sqrtf(power(peakIndex - 1));
+    float c = sqrtf(power(peakIndex + 1));
+    float denom = a - 2.0f * maxMagnitude + c;
+    float offset = denom < 0.0f ? std::max(-0.5f, std::min(0.5f, 0.5f * (a - c) / denom)) : 0.0f;
+    float currentBrpm = (peakIndex + offset) * step * 60.0f;
+
+    if (mPrevRR > 0.0f) {
+        mPrevRR = (mPrevRR * 0.7f) + (currentBrpm * 0.3f);
+    } else {
+        mPrevRR = currentBrpm;
+    }
+    return mPrevRR;
+}
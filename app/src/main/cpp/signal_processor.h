@@ -4,38 +4,192 @@
 
 #include <vector>
 #include <cmath>
-#include "kiss_fft.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include "analysis_worker.h"
+#include "arena.h"
+#include "chirp_z.h"
+#include "decimator.h"
+#include "kiss_fftr.h"
+#include "psd_estimator.h"
+#include "resampler.h"
+#include "ring_buffer.h"
+#include "sample_ring.h"
+#include "sliding_dft.h"
+#include "waveform_snapshot.h"
+#include "window_cache.h"
 
+// Spectral back-end used by computeHeartRate()
+enum class SpectralEngine {
+    BatchFft = 0,   // full FFT over the window on every call
+    SlidingDft = 1, // HR-band bins updated incrementally in addSample()
+    ZoomFft = 2,    // chirp-z transform over the HR band on a fine grid
+    Welch = 3,      // averaged overlapping half-window segments
+    Multitaper = 4  // averaged DPSS-tapered periodograms
+};
+
+// Sub-bin refinement of the spectral peak
+enum class PeakInterpolation {
+    None = 0,
+    Parabolic = 1,  // parabola through the peak and its neighbours
+    Gaussian = 2    // parabola through the log-magnitudes
+};
+
+/**
+ * Heart-rate estimator over a sliding window of samples.
+ *
+ * All window, FFT and engine scratch memory lives in one aligned arena that
+ * is sized when the processor is built (and rebuilt by the setters that
+ * change buffer geometry), so addSample() and computeHeartRate() never
+ * allocate.
+ */
 class SignalProcessor {
 public:
     SignalProcessor(int bufferSize, float samplingRate);
     ~SignalProcessor();
 
-
+    // Breaths per minute from the last 30 - 60 s of the trace, 0 until 30 s are in
     float computeRespirationRate();
 
-    void addSample(float greenValue, long timestamp);
+    // Off for traces that were band-passed to the pulse band (CHROM, POS),
+    // which carry no breathing: the decimated history is dropped and
+    // computeRespirationRate() reports 0
+    void setRespirationEnabled(bool enabled);
+    bool respirationEnabled() const { return mRespEnabled; }
+
+    void addSample(float greenValue, int64_t timestamp);
+    void addSamples(const float* values, const int64_t* timestamps, int count);
+
+    // Samples can also arrive through a shared SampleRing; they are applied
+    // whenever drainInput() runs (the JNI layer calls it before every read).
+    bool attachInput(uint8_t* memory, size_t bytes) { return mInput.attach(memory, bytes); }
+    void detachInput() { mInput.detach(); }
+    int drainInput();
+
+    // Background analysis (see AnalysisWorker). Callers on other threads hold a
+    // WorkerRef for as long as they use the processor or its worker: worker()
+    // to read results or offer samples, pauseWorker() to touch the processor
+    // itself. Start/stop swap the worker only once no WorkerRef is held.
+    void startWorker(int intervalMs);
+    void stopWorker();
+    WorkerRef worker() const;
+    WorkerRef pauseWorker() const;
+
     float computeHeartRate();
-    const std::vector<float>& getBuffer() const;
+    const float* getBuffer() const;
     int getSampleCount() const;
+
+    // Copies the window into the snapshot if samples arrived since the last
+    // publish; readers on any thread then use waveform().read()
+    void publishWaveform();
+    const WaveformSnapshot& waveform() const { return *mWaveform; }
     void reset();
 
+    void setSpectralEngine(SpectralEngine engine);
+    SpectralEngine getSpectralEngine() const { return mEngine; }
+
+    // Taper used by the batch engine (the sliding DFT is always Hamming)
+    void setWindowType(WindowType type);
+
+    // Zero-padded length of the batch FFT (>= buffer size, rounded up to even).
+    // Rebuilds the arena; not for use on the real-time path.
+    void setFftLength(int length);
+
+    // Grid spacing of the zoom engine in BPM. Rebuilds the arena.
+    void setZoomResolution(float bpmStep);
+
+    void setPeakInterpolation(PeakInterpolation mode) { mPeakInterpolation = mode; }
+
+    // Segment overlap of the Welch engine, 0 - 0.9
+    void setWelchOverlap(float overlap);
+
+    // Input timestamps are resampled onto a uniform grid at the sampling rate
+    void setResampleMode(ResampleMode mode) { mResampler.setMode(mode); }
+    float getEffectiveFps() const { return mResampler.getEffectiveFps(); }
+
+    // Peak / mean magnitude in the HR band at the last computeHeartRate(); 0 if none
+    float getPeakToNoise() const { return mPeakToNoise; }
+    float getJitterMs() const { return mResampler.getJitterMs(); }
+
 private:
     float mPrevHR = 0.0f;
+    float mPeakToNoise = 0.0f;
 
     int mBufferSize;
     float mSamplingRate;
-    std::vector<float> mRawBuffer;
-    std::vector<long> mTimeBuffer;
+    int mFftLength;
+    float mZoomStepBpm = 0.25f;
+    float mWelchOverlap = 0.5f;
+
+    SpectralEngine mEngine = SpectralEngine::BatchFft;
+    WindowType mWindowType = WindowType::Hamming;
+    PeakInterpolation mPeakInterpolation = PeakInterpolation::Parabolic;
+
+    UniformResampler mResampler;
+    SampleRing mInput;
+    double mRunningSum = 0.0;   // sum of mRawBuffer, maintained on push
+
+    // Everything below points into mArena (see allocateResources)
+    Arena mArena;
+    std::unique_ptr<RingBuffer<float>> mRawBuffer;
+    std::unique_ptr<RingBuffer<int64_t>> mTimeBuffer;
+    float* mResampledValues = nullptr;
+    int64_t* mResampledTimes = nullptr;
+
+    // FFT resources (real-input transform, mFftLength / 2 + 1 bins)
+    kiss_fftr_cfg mFftCfg = nullptr;
+    float* mFftIn = nullptr;
+    kiss_fft_cpx* mFftOut = nullptr;
+
+    // Batch / zoom windows for the analysis lengths (see WindowTables)
+    std::unique_ptr<WindowTables> mWindows;
+    std::unique_ptr<SlidingDft> mSlidingDft;
+    std::unique_ptr<ChirpZ> mChirpZ;
+    std::unique_ptr<WelchEstimator> mWelch;
+    std::unique_ptr<MultitaperEstimator> mMultitaper;
+
+    // Magnitude spectrum filled by the active engine; bin i is at
+    // mSpectrumStartHz + i * mSpectrumStepHz
+    float* mMagnitude = nullptr;
+    int mMagnitudeCount = 0;
+    float mSpectrumStartHz = 0.0f;
+    float mSpectrumStepHz = 0.0f;
+
+    // Respiration path: the trace decimated to ~3 Hz, so 60 s fits in a small ring.
+    // Its arena depends only on the sampling rate, so it is never rebuilt.
+    Arena mRespArena;
+    std::unique_ptr<FirDecimator> mDecimator;
+    std::unique_ptr<RingBuffer<float>> mRespBuffer;
+    float mRespRate = 0.0f;
+    int mRespFftLength = 0;
+    kiss_fftr_cfg mRespFftCfg = nullptr;
+    float* mRespFftIn = nullptr;
+    kiss_fft_cpx* mRespFftOut = nullptr;
+    std::unique_ptr<WindowTables> mRespWindows;
+    float mPrevRR = 0.0f;
+    bool mRespEnabled = true;
+
+    std::unique_ptr<WaveformSnapshot> mWaveform;
+    bool mWaveformDirty = false;
 
-    // FFT resources
-    kiss_fft_cfg mFftCfg;
-    std::vector<kiss_fft_cpx> mFftIn;
-    std::vector<kiss_fft_cpx> mFftOut;
+    // Declared last so it is stopped before anything it uses is torn down;
+    // replaced only under an exclusive mWorkerLock
+    mutable std::shared_mutex mWorkerLock;
+    std::unique_ptr<AnalysisWorker> mWorker;
 
     // Helpers
-    void normalizeBuffer(const std::vector<float>& input, std::vector<float>& output);
-    void applyWindow(std::vector<float>& data);
+    void allocateResources();
+    void allocateRespiration();
+    void pushUniformSample(float value, int64_t timestamp);
+    int minAnalysisLength() const;
+    void prepareWindowed(const float* samples, int N, float mean);
+    void computeBatchSpectrum(const float* samples, int N, float mean);
+    void computeSlidingSpectrum();
+    void computeZoomSpectrum(const float* samples, int N, float mean);
+    void computeAveragedSpectrum(PsdEstimator& estimator, const float* samples, int N, float mean);
+    float interpolatePeak(int peakIndex) const;
+    float trackPeak();
 };
 
 #endif //OJAS_SIGNAL_PROCESSOR_H
\ No newline at end of file
@@ -0,0 +1,129 @@
+// app/src/main/cpp/sliding_dft.cpp
+#include "sliding_dft.h"
+#include <algorithm>
+#include <cmath>
+
+// Tracked range [first - 1, last + 1] after clamping to valid bins
+static int trackedBins(int length, int firstBin, int lastBin, int* first, int* last) {
+    *first = std::max(1, firstBin);
+    *last = std::max(*first, std::min(lastBin, length / 2 - 1));
+    return *last - *first + 3;
+}
+
+size_t SlidingDft::arenaBytes(int length, int firstBin, int lastBin) {
+    int first, last;
+    int bins = trackedBins(length, firstBin, lastBin, &first, &last);
+    return 8 * Arena::bytesFor<double>(bins) + 2 * Arena::bytesFor<double>(length);
+}
+
+SlidingDft::SlidingDft(int length, int firstBin, int lastBin, Arena& arena)
+        : mLength(length) {
+
+    mBinCount = trackedBins(length, firstBin, lastBin, &mFirstBin, &mLastBin);
+
+    mRe = arena.allocate<double>(mBinCount);
+    mIm = arena.allocate<double>(mBinCount);
+    mRotRe = arena.allocate<double>(mBinCount);
+    mRotIm = arena.allocate<double>(mBinCount);
+    mInvRe = arena.allocate<double>(mBinCount);
+    mInvIm = arena.allocate<double>(mBinCount);
+    mCentredRe = arena.allocate<double>(mBinCount);
+    mCentredIm = arena.allocate<double>(mBinCount);
+    std::fill(mRe, mRe + mBinCount, 0.0);
+    std::fill(mIm, mIm + mBinCount, 0.0);
+    for (int b = 0; b < mBinCount; ++b) {
+        int k = mFirstBin - 1 + b;
+        double phase = 2.0 * M_PI * k / length;
+        mRotRe[b] = cos(phase);
+        mRotIm[b] = sin(phase);
+        // 1 - e^{-jφ} = (1 - cos φ) + j sin φ
+        double re = 1.0 - cos(phase);
+        double im = sin(phase);
+        double norm = re * re + im * im;
+        mInvRe[b] = k == 0 ? 0.0 : re / norm;
+        mInvIm[b] = k == 0 ? 0.0 : -im / norm;
+    }
+
+    mCosTable = arena.allocate<double>(length);
+    mSinTable = arena.allocate<double>(length);
+    for (int m = 0; m < length; ++m) {
+        double phase = 2.0 * M_PI * m / length;
+        mCosTable[m] = cos(phase);
+        mSinTable[m] = sin(phase);
+    }
+}
+
+void SlidingDft::push(float newest, float oldest) {
+    // S_k(n) = e^{j2πk/N} * (S_k(n-1) - x(n-N) + x(n))
+    double delta = static_cast<double>(newest) - oldest;
+    for (int b = 0; b < mBinCount; ++b) {
+        double re = mRe[b] + delta;
+        double im = mIm[b];
+        mRe[b] = re * mRotRe[b] - im * mRotIm[b];
+        mIm[b] = re * mRotIm[b] + im * mRotRe[b];
+    }
+    mSum += delta;
+    if (mCount < mLength) ++mCount;
+    ++mPushesSinceResync;
+}
+
+void SlidingDft::resync(const float* window, int count) {
+    // The window is right-aligned: missing (not yet received) samples are zeros
+    int offset = mLength - count;
+    for (int b = 0; b < mBinCount; ++b) {
+        int k = mFirstBin - 1 + b;
+        double re = 0.0;
+        double im = 0.0;
+        int idx = (k * offset) % mLength;
+        for (int m = 0; m < count; ++m) {
+            re += window[m] * mCosTable[idx];
+            im -= window[m] * mSinTable[idx];
+            idx += k;
+            if (idx >= mLength) idx -= mLength;
+        }
+        mRe[b] = re;
+        mIm[b] = im;
+    }
+    mSum = 0.0;
+    for (int m = 0; m < count; ++m) mSum += window[m];
+    mCount = count;
+    mPushesSinceResync = 0;
+}
+
+void SlidingDft::reset() {
+    std::fill(mRe, mRe + mBinCount, 0.0);
+    std::fill(mIm, mIm + mBinCount, 0.0);
+    mSum = 0.0;
+    mCount = 0;
+    mPushesSinceResync = 0;
+}
+
+void SlidingDft::magnitudes(float* out) const {
+    // Remove the mean over the occupied positions [offset, N):
+    // X'[k] = X[k] - mean * D[k], D[k] = sum_{m=offset}^{N-1} e^{-j2πkm/N}
+    //       = (e^{-j2πk·offset/N} - 1) / (1 - e^{-j2πk/N})   (k != 0)
+    const double mean = mCount > 0 ? mSum / mCount : 0.0;
+    const int offset = mLength - mCount;
+    for (int b = 0; b < mBinCount; ++b) {
+        int k = mFirstBin - 1 + b;
+        double dRe = mCount;
+        double dIm = 0.0;
+        if (k != 0) {
+            int idx = static_cast<int>(static_cast<long long>(k) * offset % mLength);
+            double aRe = mCosTable[idx] - 1.0;
+            double aIm = -mSinTable[idx];
+            dRe = aRe * mInvRe[b] - aIm * mInvIm[b];
+            dIm = aRe * mInvIm[b] + aIm * mInvRe[b];
+        }
+        mCentredRe[b] = mRe[b] - mean * dRe;
+        mCentredIm[b] = mIm[b] - mean * dIm;
+    }
+
+    // Periodic Hamming applied in the frequency domain:
+    // Xw[k] = 0.54 X[k] - 0.23 (X[k-1] + X[k+1])
+    for (int b = 1; b < mBinCount - 1; ++b) {
+        double re = 0.54 * mCentredRe[b] - 0.23 * (mCentredRe[b - 1] + mCentredRe[b + 1]);
+        double im = 0.54 * mCentredIm[b] - 0.23 * (mCentredIm[b - 1] + mCentredIm[b + 1]);
+        out[b - 1] = static_cast<float>(sqrt(re * re + im * im));
+    }
+}
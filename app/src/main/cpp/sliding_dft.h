@@ -0,0 +1,65 @@
+// app/src/main/cpp/sliding_dft.h
+#ifndef OJAS_SLIDING_DFT_H
+#define OJAS_SLIDING_DFT_H
+
+#include "arena.h"
+
+/**
+ * Sliding DFT over a fixed window of `length` samples that only tracks the
+ * bins [firstBin, lastBin]. Each push costs O(bins) instead of a full FFT.
+ *
+ * Bins are kept in double precision and periodically recomputed directly
+ * from the window (resync) so rounding error in the recursive twiddle
+ * rotation cannot accumulate.
+ *
+ * The raw recursion sees the samples' DC level, and while the window fills
+ * also the step up from the zero history; the frequency-domain window would
+ * smear both into the lowest tracked bins. magnitudes() therefore reports
+ * the spectrum of the mean-removed occupied span: the running mean times
+ * that span's DFT (a closed-form geometric series) is subtracted per bin.
+ */
+class SlidingDft {
+public:
+    // State and tables are carved from `arena`, which must have arenaBytes() free
+    SlidingDft(int length, int firstBin, int lastBin, Arena& arena);
+    static size_t arenaBytes(int length, int firstBin, int lastBin);
+
+    // newest enters the window, oldest leaves it (0 while the window fills)
+    void push(float newest, float oldest);
+
+    // Recompute all tracked bins from `count` samples, oldest first.
+    void resync(const float* window, int count);
+
+    void reset();
+
+    // Hamming-windowed magnitudes of the mean-removed window for bins
+    // [firstBin, lastBin]
+    void magnitudes(float* out) const;
+
+    int firstBin() const { return mFirstBin; }
+    int lastBin() const { return mLastBin; }
+    bool needsResync() const { return mPushesSinceResync >= mLength; }
+
+private:
+    int mLength;
+    int mFirstBin;
+    int mLastBin;
+    int mPushesSinceResync = 0;
+    int mCount = 0;         // samples in the window; the newest mCount positions
+    double mSum = 0.0;      // their sum, for the mean
+
+    // Tracked range is padded by one bin on each side for the Hamming kernel
+    int mBinCount;
+    double* mRe;
+    double* mIm;
+    double* mRotRe;     // e^{+j2πk/N} per tracked bin
+    double* mRotIm;
+    double* mInvRe;     // 1 / (1 - e^{-j2πk/N}) per tracked bin (0 for k = 0)
+    double* mInvIm;
+    double* mCentredRe; // scratch for magnitudes()
+    double* mCentredIm;
+    double* mCosTable;  // cos(2πm/N), m in [0, N)
+    double* mSinTable;
+};
+
+#endif //OJAS_SLIDING_DFT_H
@@ -0,0 +1,215 @@
+// app/src/main/cpp/tests/test_concurrency.cpp
+// Stress test for the cross-thread pieces: the SPSC SampleRing, the SeqLock,
+// the WaveformSnapshot and a SignalProcessor's AnalysisWorker being fed,
+// read, paused, stopped and restarted from other threads at once. Built
+// with -fsanitize=thread, so any data race fails the run even when the
+// values happen to come out right.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "analysis_worker.h"
+#include "sample_ring.h"
+#include "seqlock.h"
+#include "signal_processor.h"
+#include "test_util.h"
+#include "waveform_snapshot.h"
+
+// Aligned zeroed block for a ring of `records` records
+static uint8_t* ringMemory(int records, size_t* bytes) {
+    *bytes = SampleRing::kHeaderBytes + records * SampleRing::kRecordBytes;
+    void* memory = nullptr;
+    if (posix_memalign(&memory, 64, *bytes) != 0) std::abort();
+    std::fill(static_cast<uint8_t*>(memory), static_cast<uint8_t*>(memory) + *bytes, 0);
+    return static_cast<uint8_t*>(memory);
+}
+
+static void testSampleRing() {
+    const int total = 20000;
+    size_t bytes;
+    uint8_t* memory = ringMemory(64, &bytes);
+    SampleRing producer, consumer;
+    CHECK(producer.attach(memory, bytes));
+    CHECK(consumer.attach(memory, bytes));
+
+    std::thread writer([&] {
+        for (int i = 0; i < total;) {
+            if (producer.offer(static_cast<float>(i), 1000 + i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // Every record arrives once, in order, with its timestamp
+    int next = 0;
+    bool ordered = true;
+    while (next < total) {
+        int drained = consumer.drain([&](float value, int64_t timestamp) {
+            ordered = ordered && value == static_cast<float>(next) && timestamp == 1000 + next;
+            ++next;
+        });
+        if (drained == 0) std::this_thread::yield();
+    }
+    writer.join();
+    CHECK(ordered);
+    CHECK(next == total);
+    free(memory);
+}
+
+struct Wide {
+    uint32_t words[6];
+};
+
+static void testSeqLock() {
+    SeqLock<Wide> lock;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&] {
+        for (uint32_t i = 1; i <= 100000; ++i) {
+            Wide value;
+            for (uint32_t& w : value.words) w = i;
+            lock.store(value);
+        }
+        done.store(true);
+    });
+
+    // A reader never sees a mix of two stores, or time running backwards
+    auto read = [&](bool* consistent) {
+        uint32_t last = 0;
+        while (!done.load()) {
+            Wide value = lock.load();
+            for (uint32_t w : value.words) *consistent = *consistent && w == value.words[0];
+            *consistent = *consistent && value.words[0] >= last;
+            last = value.words[0];
+        }
+    };
+    bool first = true, second = true;
+    std::thread reader(read, &first);
+    read(&second);
+    writer.join();
+    reader.join();
+    CHECK(first);
+    CHECK(second);
+}
+
+static void testWaveformSnapshot() {
+    const int capacity = 64;
+    WaveformSnapshot snapshot(capacity);
+    std::atomic<bool> done(false);
+
+    // Window g holds 1 + g % capacity copies of g
+    std::thread writer([&] {
+        std::vector<float> window(capacity);
+        for (int g = 1; g <= 50000; ++g) {
+            int count = 1 + g % capacity;
+            std::fill(window.begin(), window.begin() + count, static_cast<float>(g));
+            snapshot.publish(window.data(), count);
+        }
+        done.store(true);
+    });
+
+    auto read = [&](bool* consistent) {
+        std::vector<float> out(capacity);
+        uint32_t known = 0;
+        while (!done.load()) {
+            int count = 0;
+            uint32_t generation = snapshot.read(out.data(), capacity, known, &count);
+            if (generation == known) continue;
+            known = generation;
+            *consistent = *consistent && count == static_cast<int>(1 + generation % capacity);
+            for (int i = 0; i < count; ++i) {
+                *consistent = *consistent && out[i] == static_cast<float>(generation);
+            }
+        }
+    };
+    bool first = true, second = true;
+    std::thread reader(read, &first);
+    read(&second);
+    writer.join();
+    reader.join();
+    CHECK(first);
+    CHECK(second);
+}
+
+// The JNI layer's threads, against one processor: a camera thread feeding
+// the worker queue and the shared ring, a UI thread reading results and the
+// waveform, and a settings thread pausing the worker to change the processor
+// while stopping and restarting it
+static void testWorker() {
+    const float fs = 30.0f;
+    SignalProcessor processor(300, fs);
+    size_t bytes;
+    uint8_t* memory = ringMemory(256, &bytes);
+    SampleRing ring;
+    CHECK(ring.attach(memory, bytes));
+    CHECK(processor.attachInput(memory, bytes));
+    processor.startWorker(50);
+    std::atomic<bool> done(false);
+
+    std::thread camera([&] {
+        int64_t ms = 0;
+        for (int i = 0; !done.load(); ++i, ms += 33) {
+            float value = 120.0f + static_cast<float>(i % 30) / 30.0f;
+            if (i % 2) {
+                // A full ring drops the sample rather than waiting
+                ring.offer(value, ms);
+            } else if (auto worker = processor.worker()) {
+                worker->offer(value, ms);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+
+    bool sane = true;
+    std::thread ui([&] {
+        std::vector<float> out(processor.waveform().capacity());
+        uint32_t known = 0;
+        while (!done.load()) {
+            if (auto worker = processor.worker()) {
+                AnalysisResult result = worker->latest();
+                sane = sane && result.sampleCount >= 0 && result.sampleCount <= 300;
+            }
+            int count = 0;
+            known = processor.waveform().read(out.data(), static_cast<int>(out.size()), known, &count);
+            std::this_thread::yield();
+        }
+    });
+
+    const WindowType windows[] = {WindowType::Hamming, WindowType::Hann, WindowType::Dpss};
+    for (int round = 0; round < 40; ++round) {
+        {
+            auto guard = processor.pauseWorker();
+            if (guard) {
+                processor.setWindowType(windows[round % 3]);
+                processor.drainInput();
+                if (round % 7 == 0) processor.reset();
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        if (round % 4 == 3) {
+            processor.stopWorker();
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            processor.startWorker(50 + round);
+        }
+    }
+    done.store(true);
+    camera.join();
+    ui.join();
+    CHECK(sane);
+
+    processor.stopWorker();
+    processor.detachInput();
+    free(memory);
+}
+
+int main() {
+    testSampleRing();
+    testSeqLock();
+    testWaveformSnapshot();
+    testWorker();
+    return testExit();
+}
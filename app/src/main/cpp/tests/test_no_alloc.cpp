@@ -0,0 +1,197 @@
+// app/src/main/cpp/tests/test_no_alloc.cpp
+// The analysis path must not touch the heap once a processor is built: every
+// engine is driven from an empty window through the fill phase into steady
+// state (and through a reset) while the allocator is hooked and counted.
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include "multi_channel_processor.h"
+#include "roi_fusion.h"
+#include "signal_processor.h"
+#include "test_util.h"
+
+static std::atomic<bool> gCounting(false);
+static std::atomic<long> gAllocations(0);
+
+static void countAllocation() {
+    if (gCounting.load(std::memory_order_relaxed)) {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// operator new covers the C++ containers; on glibc the C allocator is hooked
+// as well (forwarding to the __libc_ entry points), which catches
+// posix_memalign and anything built on malloc.
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    countAllocation();
+    return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    countAllocation();
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr) return ENOMEM;
+    *out = ptr;
+    return 0;
+}
+
+void free(void* ptr) {
+    __libc_free(ptr);
+}
+}
+#endif
+
+void* operator new(size_t size) {
+    countAllocation();
+    void* ptr = std::malloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+// Allocations made while fn runs
+template <typename Fn>
+static long allocationsDuring(Fn fn) {
+    gAllocations.store(0);
+    gCounting.store(true);
+    fn();
+    gCounting.store(false);
+    return gAllocations.load();
+}
+
+static float trace(int i, float fs) {
+    float t = i / fs;
+    return 120.0f + 2.0f * std::sin(2.0f * M_PI * 1.2f * t) +
+           1.0f * std::sin(2.0f * M_PI * 0.25f * t);
+}
+
+static void testHookCounts() {
+    // Guards against the hooks silently not being linked in
+    long counted = allocationsDuring([] {
+        volatile int* p = new int(1);
+        delete p;
+    });
+    CHECK(counted >= 1);
+#if defined(__GLIBC__)
+    counted = allocationsDuring([] {
+        void* p = nullptr;
+        if (posix_memalign(&p, 64, 256) == 0) free(p);
+    });
+    CHECK(counted >= 1);
+#endif
+}
+
+static void testSignalProcessor() {
+    const float fs = 30.0f;
+    const SpectralEngine engines[] = {
+            SpectralEngine::BatchFft, SpectralEngine::SlidingDft, SpectralEngine::ZoomFft,
+            SpectralEngine::Welch, SpectralEngine::Multitaper};
+    const WindowType windows[] = {WindowType::Hamming, WindowType::Dpss};
+
+    for (SpectralEngine engine : engines) {
+        for (WindowType window : windows) {
+            SignalProcessor processor(300, fs);
+            processor.setSpectralEngine(engine);
+            processor.setWindowType(window);
+
+            // 70 s covers the HR window filling (3 - 10 s) and the
+            // respiration window filling (30 - 60 s), then a reset and refill
+            long counted = allocationsDuring([&] {
+                for (int pass = 0; pass < 2; ++pass) {
+                    long ms = 0;
+                    for (int i = 0; i < 70 * 30; ++i) {
+                        ms += 33 + (i % 3 == 0);
+                        processor.addSample(trace(i, fs), ms);
+                        if (i % 15 == 0) {
+                            processor.computeHeartRate();
+                            processor.computeRespirationRate();
+                            processor.publishWaveform();
+                        }
+                    }
+                    processor.reset();
+                }
+            });
+            if (counted != 0) {
+                std::fprintf(stderr, "engine %d window %d: %ld allocations\n",
+                             static_cast<int>(engine), static_cast<int>(window), counted);
+            }
+            CHECK(counted == 0);
+        }
+    }
+}
+
+static void testMultiChannel() {
+    const float fs = 30.0f;
+    const int channels = 3;
+    MultiChannelProcessor processor(channels, 300, fs);
+    RoiFusion fusion(channels, 300, fs);
+    float frame[channels];
+
+    long counted = allocationsDuring([&] {
+        for (int i = 0; i < 20 * 30; ++i) {
+            for (int c = 0; c < channels; ++c) frame[c] = trace(i + 7 * c, fs);
+            processor.addFrame(frame);
+            fusion.addFrame(frame);
+            if (i % 15 == 0) processor.computeHeartRates();
+        }
+        processor.reset();
+        fusion.reset();
+    });
+    CHECK(counted == 0);
+}
+
+int main() {
+    testHookCounts();
+    testSignalProcessor();
+    testMultiChannel();
+    return testExit();
+}
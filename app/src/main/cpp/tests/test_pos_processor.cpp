@@ -0,0 +1,125 @@
+// app/src/main/cpp/tests/test_pos_processor.cpp
+// PosProcessor against POS computed window by window: each full window's
+// colours normalised by their mean, projected onto S1 and S2, combined with
+// alpha = std S1 / std S2, mean-removed and overlap-added into the output.
+// Several ROIs at once (lanes padded past the channel count), through the
+// fill phase and again after reset().
+#include <cmath>
+#include <random>
+#include <vector>
+#include "pos_processor.h"
+#include "test_util.h"
+
+// Random skin-like colours per ROI: distinct base levels, a weak pulse with
+// per-channel strength, slow drift and noise
+static std::vector<float> makeFrames(int channels, int frames, float fs, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> base(60.0f, 200.0f);
+    std::uniform_real_distribution<float> hz(0.8f, 2.5f);
+    std::normal_distribution<float> noise(0.0f, 0.4f);
+    std::vector<float> rgb(static_cast<size_t>(frames) * channels * 3);
+    for (int c = 0; c < channels; ++c) {
+        float level[3] = {base(rng), base(rng), base(rng)};
+        float pulse = hz(rng);
+        const float strength[3] = {0.33f, 0.77f, 0.53f};
+        for (int n = 0; n < frames; ++n) {
+            float t = n / fs;
+            float beat = std::sin(2.0f * static_cast<float>(M_PI) * pulse * t);
+            for (int k = 0; k < 3; ++k) {
+                rgb[(static_cast<size_t>(n) * channels + c) * 3 + k] =
+                        level[k] * (1.0f + 0.01f * strength[k] * beat + 0.002f * t) + noise(rng);
+            }
+        }
+    }
+    return rgb;
+}
+
+// Overlap-added POS for one ROI, in double. out[n] is frame n's sample once
+// every full window holding it is in; alphas[e] is the window ending at e.
+static void referencePos(const std::vector<float>& rgb, int channels, int channel, int window,
+                         std::vector<double>& out, std::vector<double>& alphas) {
+    int frames = static_cast<int>(rgb.size() / (channels * 3));
+    out.assign(frames, 0.0);
+    alphas.assign(frames, 0.0);
+    std::vector<double> s1(window), s2(window);
+    for (int end = window - 1; end < frames; ++end) {
+        int start = end - window + 1;
+        double mean[3] = {0.0, 0.0, 0.0};
+        for (int n = start; n <= end; ++n) {
+            for (int k = 0; k < 3; ++k) mean[k] += rgb[(static_cast<size_t>(n) * channels + channel) * 3 + k];
+        }
+        for (double& m : mean) m /= window;
+
+        double mean1 = 0.0, mean2 = 0.0;
+        for (int i = 0; i < window; ++i) {
+            const float* c = &rgb[(static_cast<size_t>(start + i) * channels + channel) * 3];
+            double r = c[0] / mean[0], g = c[1] / mean[1], b = c[2] / mean[2];
+            s1[i] = g - b;
+            s2[i] = -2.0 * r + g + b;
+            mean1 += s1[i];
+            mean2 += s2[i];
+        }
+        mean1 /= window;
+        mean2 /= window;
+        double var1 = 0.0, var2 = 0.0;
+        for (int i = 0; i < window; ++i) {
+            var1 += (s1[i] - mean1) * (s1[i] - mean1);
+            var2 += (s2[i] - mean2) * (s2[i] - mean2);
+        }
+        double alpha = std::sqrt(var1 / var2);
+        alphas[end] = alpha;
+
+        double meanH = mean1 + alpha * mean2;
+        for (int i = 0; i < window; ++i) out[start + i] += s1[i] + alpha * s2[i] - meanH;
+    }
+}
+
+static void runAgainstReference(PosProcessor& pos, const std::vector<float>& rgb, int channels,
+                                int window) {
+    int frames = static_cast<int>(rgb.size() / (channels * 3));
+    std::vector<std::vector<double>> expected(channels), alphas(channels);
+    double scale = 0.0;
+    for (int c = 0; c < channels; ++c) {
+        referencePos(rgb, channels, c, window, expected[c], alphas[c]);
+        for (double v : expected[c]) scale = std::max(scale, std::fabs(v));
+    }
+    CHECK(scale > 0.0);
+
+    for (int n = 0; n < frames; ++n) {
+        const float* out = pos.process(&rgb[static_cast<size_t>(n) * channels * 3]);
+        if (n < window - 1) {
+            CHECK(out == nullptr);
+            continue;
+        }
+        CHECK(out != nullptr);
+        if (out == nullptr) continue;
+        int frame = n - pos.latencyFrames();
+        for (int c = 0; c < channels; ++c) {
+            CHECK_NEAR(out[c], expected[c][frame], 1e-4 * scale);
+            CHECK_NEAR(pos.alpha(c), alphas[c][n], 1e-4 * alphas[c][n]);
+        }
+    }
+}
+
+static void testMatchesPerWindow() {
+    const int channels = 5;   // padded to 8 lanes
+    const float fs = 30.0f;
+    const int frames = 400;
+
+    PosProcessor pos(channels, fs);
+    const int window = pos.latencyFrames() + 1;
+    CHECK(window == 48);
+    CHECK(pos.getChannelCount() == channels);
+
+    runAgainstReference(pos, makeFrames(channels, frames, fs, 22), channels, window);
+
+    // After reset() the processor fills again from scratch and nothing of
+    // the first run leaks into the second
+    pos.reset();
+    runAgainstReference(pos, makeFrames(channels, frames, fs, 23), channels, window);
+}
+
+int main() {
+    testMatchesPerWindow();
+    return testExit();
+}
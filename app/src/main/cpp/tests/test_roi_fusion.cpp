@@ -0,0 +1,132 @@
+// app/src/main/cpp/tests/test_roi_fusion.cpp
+// RoiFusion on three POS lanes where the right cheek is dimmed, noisier and
+// carries chromatic flicker inside the HR band: its weight must fall below
+// the forehead's and the left cheek's, the weights must ramp rather than
+// step from frame to frame, and the fused trace must give a smaller HR error
+// than a plain average of the same lanes.
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "pos_processor.h"
+#include "roi_fusion.h"
+#include "signal_processor.h"
+#include "test_util.h"
+
+static const float kFs = 30.0f;
+static const int kWindow = 300;
+static const int kRois = 3;
+static const int kBadRoi = 2;
+
+struct Result {
+    double fusedError = 0.0;
+    double averageError = 0.0;
+    int readings = 0;
+};
+
+// One 60 s recording at pulseHz; HR read once a second from 15 s on
+static Result runRecording(float pulseHz, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::uniform_real_distribution<float> phase(0.0f, 2.0f * static_cast<float>(M_PI));
+    std::uniform_real_distribution<float> flickerHz(0.9f, 3.0f);
+
+    // Forehead, left cheek, right cheek: skin level, pulse depth per channel
+    // (strongest in green), sensor noise
+    const float level[kRois] = {1.0f, 0.95f, 0.35f};
+    const float noiseSd[kRois] = {0.3f, 0.3f, 0.9f};
+    const float skin[3] = {170.0f, 120.0f, 95.0f};
+    const float depth[3] = {0.0025f, 0.006f, 0.004f};
+    // Flicker on the dim cheek: three tones away from the pulse, each with
+    // its own colour cast so POS cannot project it out
+    float tones[3], tonePhase[3];
+    for (int k = 0; k < 3; ++k) {
+        do {
+            tones[k] = flickerHz(rng);
+        } while (std::fabs(tones[k] - pulseHz) < 0.25f);
+        tonePhase[k] = phase(rng);
+    }
+    const float cast[3][3] = {{1.2f, 0.2f, -0.6f}, {-0.4f, 0.9f, 0.3f}, {0.5f, -0.7f, 1.0f}};
+
+    PosProcessor pos(kRois, kFs);
+    RoiFusion fusion(kRois, kWindow, kFs);
+    SignalProcessor fused(kWindow, kFs);
+    SignalProcessor average(kWindow, kFs);
+    fused.setRespirationEnabled(false);
+    average.setRespirationEnabled(false);
+
+    Result result;
+    float previous[kRois];
+    std::copy(fusion.getWeights(), fusion.getWeights() + kRois, previous);
+    float largestWeight = 0.0f, largestStep = 0.0f;
+    const int frames = static_cast<int>(60 * kFs);
+    float rgb[3 * kRois];
+    for (int n = 0; n < frames; ++n) {
+        float t = n / kFs;
+        float beat = std::sin(2.0f * static_cast<float>(M_PI) * pulseHz * t);
+        for (int c = 0; c < kRois; ++c) {
+            for (int k = 0; k < 3; ++k) {
+                float value = level[c] * skin[k] * (1.0f + depth[k] * beat) + noiseSd[c] * noise(rng);
+                if (c == kBadRoi) {
+                    for (int j = 0; j < 3; ++j) {
+                        value += 0.2f * cast[j][k] *
+                                 std::sin(2.0f * static_cast<float>(M_PI) * tones[j] * t + tonePhase[j]);
+                    }
+                }
+                rgb[3 * c + k] = value;
+            }
+        }
+
+        const float* lanes = pos.process(rgb);
+        if (lanes == nullptr) continue;
+        int64_t ms = static_cast<int64_t>(n * 1000.0f / kFs);
+        fused.addSample(fusion.addFrame(lanes), ms);
+        average.addSample((lanes[0] + lanes[1] + lanes[2]) / kRois, ms);
+
+        // Weights only ever move by a ramp step per frame
+        const float* weights = fusion.getWeights();
+        for (int c = 0; c < kRois; ++c) {
+            largestWeight = std::max(largestWeight, std::fabs(weights[c]));
+            largestStep = std::max(largestStep, std::fabs(weights[c] - previous[c]));
+            previous[c] = weights[c];
+        }
+
+        if (n >= 15 * kFs && n % static_cast<int>(kFs) == 0) {
+            CHECK(weights[kBadRoi] < weights[0]);
+            CHECK(weights[kBadRoi] < weights[1]);
+            result.fusedError += std::fabs(fused.computeHeartRate() - 60.0f * pulseHz);
+            result.averageError += std::fabs(average.computeHeartRate() - 60.0f * pulseHz);
+            ++result.readings;
+        }
+    }
+    // A weight that jumped to its new estimate would move by a sizeable
+    // share of its value in one frame; a one-second ramp moves it by ~1/30
+    CHECK(largestWeight > 0.0f);
+    CHECK(largestStep < largestWeight / 10.0f);
+    return result;
+}
+
+static void testDimNoisyCheek() {
+    double fusedError = 0.0, averageError = 0.0;
+    int readings = 0;
+    unsigned seed = 24;
+    for (float hz : {1.0f, 1.3f, 1.7f, 2.2f}) {
+        for (int i = 0; i < 3; ++i) {
+            Result r = runRecording(hz, seed++);
+            fusedError += r.fusedError;
+            averageError += r.averageError;
+            readings += r.readings;
+        }
+    }
+    CHECK(readings > 0);
+    fusedError /= readings;
+    averageError /= readings;
+    std::printf("HR MAE: plain average %.2f bpm, fused %.2f bpm\n", averageError, fusedError);
+    CHECK(fusedError < averageError);
+    CHECK(fusedError < 2.0);
+}
+
+int main() {
+    testDimNoisyCheek();
+    return testExit();
+}
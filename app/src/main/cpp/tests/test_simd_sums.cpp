@@ -0,0 +1,171 @@
+// app/src/main/cpp/tests/test_simd_sums.cpp
+// Every vector path of the span kernels against scalar loops, bit for bit:
+// channel sums and RGBA moments with the ARMv8.2 dot-product (UDOT) loops on
+// and off on arm64, and with AVX2 on and off (the SSE4.1 baseline) on
+// x86_64; a path the CPU lacks is skipped. Also the YUV ROI statistics
+// (plain and skin-masked, planar and semi-planar chroma) from the UDOT
+// kernel against the widening loops, which test_yuv_stats checks against an
+// RGBA reference. Cross-compiled for arm64, ctest runs this through
+// CMAKE_CROSSCOMPILING_EMULATOR, e.g. "qemu-aarch64;-cpu;max".
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "frame_stats.h"
+#include "roi_extractor.h"
+#include "test_util.h"
+
+// Modes to run: the default, plus the widening loops if the default is UDOT
+static std::vector<bool> modes() {
+    static const bool kDefault = dotProdEnabled();
+    if (kDefault) return {true, false};
+    return {false};
+}
+
+// Vector paths for the span kernels: each mode above, then the SSE4.1
+// baseline where the default is AVX2
+struct Path {
+    bool dot;
+    bool avx2;
+};
+
+static std::vector<Path> paths() {
+    static const bool kAvx2 = avx2Enabled();
+    std::vector<Path> all;
+    for (bool dot : modes()) all.push_back({dot, kAvx2});
+    if (kAvx2) all.push_back({false, false});
+    return all;
+}
+
+static void select(const Path& path) {
+    setDotProdEnabled(path.dot);
+    setAvx2Enabled(path.avx2);
+}
+
+static void testChannelSums() {
+    std::mt19937 rng(20);
+    std::vector<uint8_t> buffer(4 * 1200);
+    for (auto& b : buffer) b = static_cast<uint8_t>(rng());
+
+    for (const Path& path : paths()) {
+        select(path);
+        bool exact = true;
+        for (int trial = 0; trial < 4000; ++trial) {
+            const int stride = 1 + static_cast<int>(rng() % 4);
+            const int channel = static_cast<int>(rng() % stride);
+            const int count = static_cast<int>(rng() % 1100);
+            const uint8_t* row = buffer.data() + rng() % 64;
+            uint32_t expected = 0;
+            for (int i = 0; i < count; ++i) expected += row[i * stride + channel];
+            exact = exact && sumChannelSpan(row, count, stride, channel) == expected;
+        }
+        CHECK(exact);
+    }
+}
+
+static void testRgbaMoments() {
+    std::mt19937 rng(21);
+    std::vector<uint8_t> random(4 * 5000);
+    for (auto& b : random) b = static_cast<uint8_t>(rng());
+    // Saturated and long enough to cross the UDOT kernel's u64 flush
+    std::vector<uint8_t> saturated(4 * 100000, 255);
+
+    auto matches = [](const uint8_t* row, int count) {
+        uint64_t sums[3] = {}, squares[3] = {}, expectedSums[3] = {}, expectedSquares[3] = {};
+        for (int i = 0; i < count; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                uint64_t value = row[4 * i + c];
+                expectedSums[c] += value;
+                expectedSquares[c] += value * value;
+            }
+        }
+        accumulateRgbaSpan(row, count, sums, squares);
+        bool same = true;
+        for (int c = 0; c < 3; ++c) same = same && sums[c] == expectedSums[c] && squares[c] == expectedSquares[c];
+        return same;
+    };
+
+    for (const Path& path : paths()) {
+        select(path);
+        bool exact = true;
+        for (int trial = 0; trial < 2000; ++trial) {
+            const int offset = static_cast<int>(rng() % 16);
+            const int count = static_cast<int>(rng() % (5000 - offset));
+            exact = exact && matches(random.data() + 4 * offset, count);
+        }
+        CHECK(exact);
+        CHECK(matches(saturated.data(), 100000));
+    }
+}
+
+static bool sameStats(const RoiStats& a, const RoiStats& b) {
+    bool same = a.pixels == b.pixels;
+    for (int c = 0; c < 3; ++c) same = same && a.mean[c] == b.mean[c] && a.variance[c] == b.variance[c];
+    return same;
+}
+
+static void testYuvStats() {
+    if (modes().size() < 2) {
+        std::printf("no dot-product path on this CPU; YUV comparison skipped\n");
+        return;
+    }
+    std::mt19937 rng(22);
+    static const SkinThresholds kSkin;
+    for (int uvStep = 1; uvStep <= 2; ++uvStep) {
+        // Odd width, so spans end on a lone luma column and at the last chroma sample
+        const int width = 333, height = 120;
+        const int chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+        const int uvRowStride = chromaWidth * uvStep + 5;
+        // Wide ranges, so about half the pixels pass the skin test
+        std::vector<uint8_t> luma(static_cast<size_t>(width) * height);
+        for (auto& b : luma) b = static_cast<uint8_t>(20 + rng() % 236);
+        const size_t planeBytes = static_cast<size_t>(uvRowStride) * chromaHeight;
+        std::vector<uint8_t> chroma(2 * planeBytes);
+        for (auto& b : chroma) b = static_cast<uint8_t>(60 + rng() % 130);
+
+        PlaneView y{luma.data(), luma.size(), width, height, width, 1};
+        PlaneView u, v;
+        if (uvStep == 2) {
+            size_t bytes = static_cast<size_t>(uvRowStride) * (chromaHeight - 1) + 2 * (chromaWidth - 1) + 1;
+            u = {chroma.data(), bytes, chromaWidth, chromaHeight, uvRowStride, 2};
+            v = {chroma.data() + 1, bytes, chromaWidth, chromaHeight, uvRowStride, 2};
+        } else {
+            u = {chroma.data(), planeBytes, chromaWidth, chromaHeight, uvRowStride, 1};
+            v = {chroma.data() + planeBytes, planeBytes, chromaWidth, chromaHeight, uvRowStride, 1};
+        }
+        const YuvFrame frame{y, u, v, 0};
+
+        bool same = true;
+        for (int trial = 0; trial < 300; ++trial) {
+            // Random quadrilateral; every tenth covers the whole frame
+            float points[8];
+            if (trial % 10 == 0) {
+                const float whole[] = {0, 0, static_cast<float>(width), 0,
+                                       static_cast<float>(width), static_cast<float>(height),
+                                       0, static_cast<float>(height)};
+                std::copy(whole, whole + 8, points);
+            } else {
+                for (int p = 0; p < 4; ++p) {
+                    points[2 * p] = static_cast<float>(rng() % (width + 40)) - 20.0f;
+                    points[2 * p + 1] = static_cast<float>(rng() % (height + 40)) - 20.0f;
+                }
+            }
+            for (const SkinThresholds* skin : {static_cast<const SkinThresholds*>(nullptr), &kSkin}) {
+                setDotProdEnabled(true);
+                RoiStats dot = convexRoiStatsYuv(frame, points, 4, nullptr, skin);
+                setDotProdEnabled(false);
+                RoiStats widening = convexRoiStatsYuv(frame, points, 4, nullptr, skin);
+                same = same && sameStats(dot, widening);
+            }
+        }
+        CHECK(same);
+    }
+}
+
+int main() {
+    testChannelSums();
+    testRgbaMoments();
+    testYuvStats();
+    std::printf("%d span path(s) checked\n", static_cast<int>(paths().size()));
+    return testExit();
+}
@@ -0,0 +1,133 @@
+// app/src/main/cpp/tests/test_sliding_dft.cpp
+// The sliding DFT against a batch FFT: bin-for-bin on the mean-removed,
+// Hamming-windowed window (while filling and once full, across resyncs), and
+// the heart rate the two engines report for the same trace.
+#include <cmath>
+#include <random>
+#include <vector>
+#include "arena.h"
+#include "kiss_fftr.h"
+#include "signal_processor.h"
+#include "sliding_dft.h"
+#include "test_util.h"
+
+// |FFT| of the right-aligned window (zeros before the first sample) after
+// removing the mean of the occupied span and applying a periodic Hamming
+static std::vector<float> referenceMagnitudes(const std::vector<float>& samples, int length) {
+    int count = static_cast<int>(samples.size());
+    int offset = length - count;
+    double mean = 0.0;
+    for (float v : samples) mean += v;
+    mean /= count;
+
+    std::vector<float> in(length, 0.0f);
+    for (int m = 0; m < count; ++m) {
+        int n = offset + m;
+        double w = 0.54 - 0.46 * cos(2.0 * M_PI * n / length);
+        in[n] = static_cast<float>((samples[m] - mean) * w);
+    }
+    std::vector<kiss_fft_cpx> out(length / 2 + 1);
+    kiss_fftr_cfg cfg = kiss_fftr_alloc(length, 0, nullptr, nullptr);
+    kiss_fftr(cfg, in.data(), out.data());
+    kiss_fftr_free(cfg);
+
+    std::vector<float> mags(out.size());
+    for (size_t k = 0; k < out.size(); ++k) mags[k] = std::hypot(out[k].r, out[k].i);
+    return mags;
+}
+
+static void testBinsMatchBatch() {
+    const int length = 300;
+    const float fs = 30.0f;
+    const int firstBin = 7;   // 0.7 Hz
+    const int lastBin = 40;   // 4 Hz
+
+    Arena arena;
+    arena.reset(SlidingDft::arenaBytes(length, firstBin, lastBin));
+    SlidingDft dft(length, firstBin, lastBin, arena);
+    int bins = dft.lastBin() - dft.firstBin() + 1;
+    std::vector<float> mags(bins);
+
+    // Large DC offset plus slow drift, a 1.2 Hz pulse and noise
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    std::vector<float> trace(4 * length);
+    for (size_t i = 0; i < trace.size(); ++i) {
+        float t = i / fs;
+        trace[i] = 140.0f + 0.05f * t + std::sin(2.0f * M_PI * 1.2f * t) + noise(rng);
+    }
+
+    for (size_t i = 0; i < trace.size(); ++i) {
+        float oldest = i >= static_cast<size_t>(length) ? trace[i - length] : 0.0f;
+        dft.push(trace[i], oldest);
+        if (dft.needsResync()) {
+            size_t first = i + 1 >= static_cast<size_t>(length) ? i + 1 - length : 0;
+            dft.resync(&trace[first], static_cast<int>(i + 1 - first));
+        }
+        // Compare at a spread of fill levels and once full
+        if (i < 2 || (i + 1) % 37 != 0) continue;
+
+        size_t first = i + 1 >= static_cast<size_t>(length) ? i + 1 - length : 0;
+        std::vector<float> window(trace.begin() + first, trace.begin() + i + 1);
+        std::vector<float> ref = referenceMagnitudes(window, length);
+        dft.magnitudes(mags.data());
+
+        float peak = 0.0f;
+        for (int b = 0; b < bins; ++b) peak = std::max(peak, ref[dft.firstBin() + b]);
+        for (int b = 0; b < bins; ++b) {
+            CHECK_NEAR(mags[b], ref[dft.firstBin() + b], 1e-3 * peak + 1e-3);
+        }
+    }
+}
+
+// Feeds the same trace to a sliding-DFT and a batch-FFT processor and
+// returns the largest disagreement in BPM from `fromSeconds` on
+static float engineDisagreement(float pulseHz, float dc, float fromSeconds,
+                                float* slidingErr, float* batchErr) {
+    const float fs = 30.0f;
+    SignalProcessor sliding(300, fs);
+    SignalProcessor batch(300, fs);
+    sliding.setSpectralEngine(SpectralEngine::SlidingDft);
+    batch.setSpectralEngine(SpectralEngine::BatchFft);
+
+    std::mt19937 rng(11);
+    std::normal_distribution<float> noise(0.0f, 0.2f);
+    float worst = 0.0f;
+    *slidingErr = 0.0f;
+    *batchErr = 0.0f;
+    for (int i = 0; i < 20 * 30; ++i) {
+        float t = i / fs;
+        float v = dc + 2.0f * std::sin(2.0f * M_PI * pulseHz * t) + noise(rng);
+        long ms = static_cast<long>(std::lround(i * 1000.0 / fs));
+        sliding.addSample(v, ms);
+        batch.addSample(v, ms);
+        if (t < fromSeconds || i % 15 != 0) continue;
+
+        float hrSliding = sliding.computeHeartRate();
+        float hrBatch = batch.computeHeartRate();
+        worst = std::max(worst, std::fabs(hrSliding - hrBatch));
+        *slidingErr = std::max(*slidingErr, std::fabs(hrSliding - pulseHz * 60.0f));
+        *batchErr = std::max(*batchErr, std::fabs(hrBatch - pulseHz * 60.0f));
+    }
+    return worst;
+}
+
+static void testEnginesAgree() {
+    // A camera-level DC offset must not pull the sliding estimate to the band
+    // floor while the window fills (from ~4 s) or once it is full
+    for (float dc : {0.0f, 128.0f, 230.0f}) {
+        for (float hz : {1.0f, 1.3f, 2.0f}) {
+            float slidingErr, batchErr;
+            float worst = engineDisagreement(hz, dc, 4.0f, &slidingErr, &batchErr);
+            CHECK(slidingErr < 6.0f);
+            CHECK(batchErr < 6.0f);
+            CHECK(worst < 6.0f);
+        }
+    }
+}
+
+int main() {
+    testBinsMatchBatch();
+    testEnginesAgree();
+    return testExit();
+}
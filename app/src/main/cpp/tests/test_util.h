@@ -0,0 +1,44 @@
+// app/src/main/cpp/tests/test_util.h
+#ifndef OJAS_TEST_UTIL_H
+#define OJAS_TEST_UTIL_H
+
+#include <cstdio>
+#include <cstdlib>
+
+// Minimal assertion helpers for the host tests: a failed CHECK reports and
+// counts, and testExit() turns the count into the process exit status ctest reads.
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n",               \
+                         __FILE__, __LINE__, #cond);                        \
+            ++testFailures();                                               \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tol)                                               \
+    do {                                                                    \
+        double va_ = (a), vb_ = (b);                                        \
+        if (!(va_ - vb_ <= (tol) && vb_ - va_ <= (tol))) {                  \
+            std::fprintf(stderr, "%s:%d: CHECK_NEAR failed: %s = %g, %s = %g (tol %g)\n", \
+                         __FILE__, __LINE__, #a, va_, #b, vb_, (double)(tol)); \
+            ++testFailures();                                               \
+        }                                                                   \
+    } while (0)
+
+inline int testExit() {
+    if (testFailures() == 0) {
+        std::printf("OK\n");
+        return EXIT_SUCCESS;
+    }
+    std::fprintf(stderr, "%d check(s) failed\n", testFailures());
+    return EXIT_FAILURE;
+}
+
+#endif //OJAS_TEST_UTIL_H
@@ -0,0 +1,240 @@
+// app/src/main/cpp/tests/test_yuv_stats.cpp
+// convexRoiStatsYuv against convexRoiStats on a reference RGBA conversion of
+// the same planes (BT.601 limited range, rotated upright, cut to the crop),
+// over every rotation, planar and semi-planar chroma, padded row strides and
+// crop rectangles with odd offsets; the multi-ROI pass against one call per
+// ROI, and the masked kernel against the plain one.
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "roi_extractor.h"
+#include "test_util.h"
+
+static uint8_t toByte(float value) {
+    return static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, std::round(value))));
+}
+
+struct TestFrame {
+    std::vector<uint8_t> luma;
+    std::vector<uint8_t> chroma;
+    YuvFrame frame;
+};
+
+static TestFrame makeFrame(std::mt19937& rng, int width, int height, int uvStep, int rotation) {
+    TestFrame t;
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    const int yRowStride = width + static_cast<int>(rng() % 24);
+    const int uvRowStride = chromaWidth * uvStep + static_cast<int>(rng() % 24);
+
+    // Ranges that keep every converted channel inside [0, 255]
+    t.luma.resize(static_cast<size_t>(yRowStride) * height);
+    for (auto& b : t.luma) b = static_cast<uint8_t>(60 + rng() % 120);
+    const size_t planeBytes = static_cast<size_t>(uvRowStride) * chromaHeight;
+    t.chroma.resize(2 * planeBytes);
+    for (auto& b : t.chroma) b = static_cast<uint8_t>(108 + rng() % 40);
+
+    PlaneView y{t.luma.data(), t.luma.size(), width, height, yRowStride, 1};
+    PlaneView u, v;
+    if (uvStep == 2) {
+        // Semi-planar: U and V interleaved in one buffer, V one byte behind
+        size_t bytes = static_cast<size_t>(uvRowStride) * (chromaHeight - 1) + 2 * (chromaWidth - 1) + 1;
+        u = {t.chroma.data(), bytes, chromaWidth, chromaHeight, uvRowStride, 2};
+        v = {t.chroma.data() + 1, bytes, chromaWidth, chromaHeight, uvRowStride, 2};
+    } else {
+        u = {t.chroma.data(), planeBytes, chromaWidth, chromaHeight, uvRowStride, 1};
+        v = {t.chroma.data() + planeBytes, planeBytes, chromaWidth, chromaHeight, uvRowStride, 1};
+    }
+    t.frame = YuvFrame{y, u, v, rotation};
+    return t;
+}
+
+// Upright RGBA of the crop rectangle, converted pixel by pixel the way
+// CameraX's RGBA_8888 output does; (originX, originY) is the crop's upright
+// top-left corner in whole-frame coordinates
+static std::vector<uint8_t> referenceRgba(const YuvFrame& f, int* uprightWidth, int* uprightHeight,
+                                          int* originX, int* originY) {
+    const int W = f.y.width, H = f.y.height;
+    const int L = f.cropLeft, T = f.cropTop, R = f.cropRight, B = f.cropBottom;
+    const bool sideways = f.rotation == 90 || f.rotation == 270;
+    const int cw = R - L, ch = B - T;
+    *uprightWidth = sideways ? ch : cw;
+    *uprightHeight = sideways ? cw : ch;
+    switch (f.rotation) {
+        case 90: *originX = H - B; *originY = L; break;
+        case 180: *originX = W - R; *originY = H - B; break;
+        case 270: *originX = T; *originY = W - R; break;
+        default: *originX = L; *originY = T; break;
+    }
+
+    std::vector<uint8_t> rgba(static_cast<size_t>(cw) * ch * 4);
+    for (int ys = T; ys < B; ++ys) {
+        for (int xs = L; xs < R; ++xs) {
+            float luma = 1.164f * (f.y.data[static_cast<size_t>(ys) * f.y.rowStride + xs] - 16);
+            size_t c = static_cast<size_t>(ys / 2) * f.u.rowStride + static_cast<size_t>(xs / 2) * f.u.pixelStride;
+            float cb = f.u.data[c] - 128.0f;
+            float cr = f.v.data[c] - 128.0f;
+
+            // Sensor pixel -> upright pixel (whole frame), then into the crop
+            int xu, yu;
+            switch (f.rotation) {
+                case 90: xu = H - 1 - ys; yu = xs; break;
+                case 180: xu = W - 1 - xs; yu = H - 1 - ys; break;
+                case 270: xu = ys; yu = W - 1 - xs; break;
+                default: xu = xs; yu = ys; break;
+            }
+            xu -= *originX;
+            yu -= *originY;
+            uint8_t* p = &rgba[(static_cast<size_t>(yu) * *uprightWidth + xu) * 4];
+            p[0] = toByte(luma + 1.596f * cr);
+            p[1] = toByte(luma - 0.391f * cb - 0.813f * cr);
+            p[2] = toByte(luma + 2.018f * cb);
+            p[3] = 255;
+        }
+    }
+    return rgba;
+}
+
+static void testAgainstRgba() {
+    std::mt19937 rng(13);
+    int compared = 0;
+    for (int trial = 0; trial < 96; ++trial) {
+        const int rotation = 90 * (trial % 4);
+        const int uvStep = 1 + (trial / 4) % 2;
+        // Odd and even frame sizes
+        const int width = 64 + static_cast<int>(rng() % 160);
+        const int height = 48 + static_cast<int>(rng() % 120);
+        TestFrame t = makeFrame(rng, width, height, uvStep, rotation);
+
+        // Every third frame uses the whole plane; the rest a crop whose
+        // offsets are odd half the time, so spans start mid chroma sample
+        if (trial % 3 != 0) {
+            int left = static_cast<int>(rng() % (width / 4));
+            int top = static_cast<int>(rng() % (height / 4));
+            if ((trial / 8) % 2) {
+                left |= 1;
+                top |= 1;
+            }
+            t.frame.cropLeft = left;
+            t.frame.cropTop = top;
+            t.frame.cropRight = width - static_cast<int>(rng() % (width / 4));
+            t.frame.cropBottom = height - static_cast<int>(rng() % (height / 4));
+        } else {
+            t.frame.cropRight = width;
+            t.frame.cropBottom = height;
+        }
+
+        int uw, uh, ox, oy;
+        std::vector<uint8_t> rgba = referenceRgba(t.frame, &uw, &uh, &ox, &oy);
+        PlaneView upright{rgba.data(), rgba.size(), uw, uh, uw * 4, 4};
+        const int frameWidth = rotation % 180 ? height : width;
+        const int frameHeight = rotation % 180 ? width : height;
+
+        for (int roi = 0; roi < 6; ++roi) {
+            // Random convex-ish blobs anywhere in the frame, some crossing the crop edge
+            const int n = 3 + static_cast<int>(rng() % 8);
+            const float cx = static_cast<float>(rng() % frameWidth);
+            const float cy = static_cast<float>(rng() % frameHeight);
+            const float r = 3.0f + static_cast<float>(rng() % 50);
+            std::vector<float> points(2 * n), shifted(2 * n);
+            for (int i = 0; i < n; ++i) {
+                points[2 * i] = cx + r * (static_cast<float>(rng() % 2001) / 1000.0f - 1.0f);
+                points[2 * i + 1] = cy + r * (static_cast<float>(rng() % 2001) / 1000.0f - 1.0f);
+                shifted[2 * i] = points[2 * i] - ox;
+                shifted[2 * i + 1] = points[2 * i + 1] - oy;
+            }
+
+            RoiStats expected = convexRoiStats(upright, shifted.data(), n);
+            RoiStats actual = convexRoiStatsYuv(t.frame, points.data(), n);
+            CHECK(actual.pixels == expected.pixels);
+            if (actual.pixels != expected.pixels || expected.pixels == 0) continue;
+
+            // The reference rounds every pixel by up to 0.5, which moves the
+            // mean by at most 0.5 and the variance by at most sigma + 0.25
+            for (int c = 0; c < 3; ++c) {
+                CHECK_NEAR(actual.mean[c], expected.mean[c], 0.5);
+                CHECK_NEAR(actual.variance[c], expected.variance[c],
+                           std::sqrt(expected.variance[c]) + 0.25);
+            }
+            ++compared;
+        }
+    }
+    CHECK(compared > 200);
+}
+
+static bool sameStats(const RoiStats& a, const RoiStats& b) {
+    if (a.pixels != b.pixels) return false;
+    for (int c = 0; c < 3; ++c) {
+        if (a.mean[c] != b.mean[c] || a.variance[c] != b.variance[c]) return false;
+    }
+    return true;
+}
+
+static void testOnePassMatchesPerRoi() {
+    std::mt19937 rng(14);
+    SkinThresholds anyPixel;
+    anyPixel.minY = 0; anyPixel.maxY = 255;
+    anyPixel.minCb = 0; anyPixel.maxCb = 255;
+    anyPixel.minCr = 0; anyPixel.maxCr = 255;
+    anyPixel.minCrMinusCb = 0;
+    // Wide enough to the chroma range of makeFrame that some pixels pass and some do not
+    SkinThresholds some;
+    some.minCb = 112; some.maxCb = 140;
+    some.minCr = 116; some.maxCr = 144;
+    some.minCrMinusCb = 2;
+    const SkinThresholds* masks[] = {nullptr, &anyPixel, &some};
+
+    for (int trial = 0; trial < 48; ++trial) {
+        const int width = 96 + static_cast<int>(rng() % 160);
+        const int height = 64 + static_cast<int>(rng() % 120);
+        TestFrame t = makeFrame(rng, width, height, 1 + trial % 2, 90 * ((trial / 2) % 4));
+        const int frameWidth = t.frame.rotation % 180 ? height : width;
+        const int frameHeight = t.frame.rotation % 180 ? width : height;
+
+        // Up to kMaxRois blobs around one centre, so most of them overlap
+        const int rois = 1 + static_cast<int>(rng() % kMaxRois);
+        std::vector<float> points;
+        std::vector<int> starts{0};
+        const float cx = static_cast<float>(rng() % frameWidth);
+        const float cy = static_cast<float>(rng() % frameHeight);
+        for (int r = 0; r < rois; ++r) {
+            const int n = 3 + static_cast<int>(rng() % 10);
+            const float ox = cx + static_cast<float>(static_cast<int>(rng() % 41) - 20);
+            const float oy = cy + static_cast<float>(static_cast<int>(rng() % 41) - 20);
+            const float radius = 4.0f + static_cast<float>(rng() % 60);
+            for (int i = 0; i < n; ++i) {
+                points.push_back(ox + radius * (static_cast<float>(rng() % 2001) / 1000.0f - 1.0f));
+                points.push_back(oy + radius * (static_cast<float>(rng() % 2001) / 1000.0f - 1.0f));
+            }
+            starts.push_back(starts.back() + n);
+        }
+
+        for (const SkinThresholds* skin : masks) {
+            RoiStats together[kMaxRois];
+            convexRoiStatsYuv(t.frame, points.data(), starts.data(), rois, together, nullptr, skin);
+            for (int r = 0; r < rois; ++r) {
+                RoiStats alone = convexRoiStatsYuv(t.frame, points.data() + 2 * starts[r],
+                                                   starts[r + 1] - starts[r], nullptr, skin);
+                CHECK(sameStats(together[r], alone));
+                // A mask that admits everything must not change a moment
+                if (skin == &anyPixel) {
+                    RoiStats plain = convexRoiStatsYuv(t.frame, points.data() + 2 * starts[r],
+                                                       starts[r + 1] - starts[r]);
+                    CHECK(sameStats(alone, plain));
+                }
+                if (skin == &some) {
+                    RoiStats plain = convexRoiStatsYuv(t.frame, points.data() + 2 * starts[r],
+                                                       starts[r + 1] - starts[r]);
+                    CHECK(alone.pixels <= plain.pixels);
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    testAgainstRgba();
+    testOnePassMatchesPerRoi();
+    return testExit();
+}
@@ -0,0 +1,96 @@
+// app/src/main/cpp/thread_pool.cpp
+#include "thread_pool.h"
+#include <chrono>
+
+// Until calibrate() runs: below this many pixels a reduction finishes
+// before the workers wake up
+static constexpr long kDefaultMinParallelPixels = 256 * 1024;
+static constexpr int kCalibrationRuns = 15;
+static constexpr int kMinTileRows = 16;
+static constexpr int kMaxFrameThreads = 4;
+
+ThreadPool::ThreadPool(int threads) : mMinParallelPixels(kDefaultMinParallelPixels) {
+    for (int i = 1; i < threads; ++i) {
+        mWorkers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mStop = true;
+    }
+    mWake.notify_all();
+    for (std::thread& worker : mWorkers) worker.join();
+}
+
+ThreadPool& ThreadPool::frames() {
+    static ThreadPool pool(std::max(1, std::min<int>(kMaxFrameThreads,
+                                                     std::thread::hardware_concurrency())));
+    return pool;
+}
+
+long ThreadPool::calibrate(double nanosPerPixel) {
+    if (mWorkers.empty() || nanosPerPixel <= 0.0) return minParallelPixels();
+    // Median of runs spaced out so the workers are asleep, as between frames
+    auto nothing = [](int) {};
+    double nanos[kCalibrationRuns];
+    for (double& n : nanos) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        auto start = std::chrono::steady_clock::now();
+        run(size(), nothing);
+        n = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::nth_element(nanos, nanos + kCalibrationRuns / 2, nanos + kCalibrationRuns);
+    const double offloaded = 1.0 - 1.0 / size();
+    setMinParallelPixels(static_cast<long>(nanos[kCalibrationRuns / 2] / (nanosPerPixel * offloaded)));
+    return minParallelPixels();
+}
+
+void ThreadPool::dispatch(int tasks, TaskFn task, void* context) {
+    std::lock_guard<std::mutex> run(mRunLock);
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mTask = task;
+        mContext = context;
+        mTaskCount = tasks;
+        mNext.store(0, std::memory_order_relaxed);
+        mActive = static_cast<int>(mWorkers.size());
+        ++mGeneration;
+    }
+    mWake.notify_all();
+
+    runTasks();
+
+    std::unique_lock<std::mutex> lock(mLock);
+    mDone.wait(lock, [this] { return mActive == 0; });
+}
+
+void ThreadPool::workerLoop() {
+    unsigned seen = 0;
+    std::unique_lock<std::mutex> lock(mLock);
+    for (;;) {
+        mWake.wait(lock, [&] { return mStop || mGeneration != seen; });
+        if (mStop) return;
+        seen = mGeneration;
+
+        lock.unlock();
+        runTasks();
+        lock.lock();
+        if (--mActive == 0) mDone.notify_one();
+    }
+}
+
+void ThreadPool::runTasks() {
+    for (int t = mNext.fetch_add(1, std::memory_order_relaxed); t < mTaskCount;
+         t = mNext.fetch_add(1, std::memory_order_relaxed)) {
+        mTask(mContext, t);
+    }
+}
+
+int rowTileCount(const ThreadPool* pool, int rows, int columns) {
+    if (!pool || pool->size() < 2 || static_cast<long>(rows) * columns < pool->minParallelPixels()) return 1;
+    // A few tiles per thread evens out cores running at different speeds
+    int tiles = std::min(4 * pool->size(), rows / kMinTileRows);
+    return std::max(1, std::min(kMaxRowTiles, tiles));
+}
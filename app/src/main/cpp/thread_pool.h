@@ -0,0 +1,116 @@
+// app/src/main/cpp/thread_pool.h
+#ifndef OJAS_THREAD_POOL_H
+#define OJAS_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Small persistent pool for splitting one frame reduction across cores.
+ *
+ * run() hands out task indices 0 .. tasks - 1 from an atomic counter to the
+ * workers and the calling thread, and returns once all have finished. Runs
+ * from different threads are serialised. Nothing is allocated per run.
+ */
+class ThreadPool {
+public:
+    // `threads` counts the caller, so 1 means no workers
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return static_cast<int>(mWorkers.size()) + 1; }
+
+    // Reductions over fewer pixels run inline (see rowTileCount)
+    long minParallelPixels() const { return mMinParallelPixels.load(std::memory_order_relaxed); }
+    void setMinParallelPixels(long pixels) {
+        mMinParallelPixels.store(std::max(0L, pixels), std::memory_order_relaxed);
+    }
+
+    /**
+     * Sets minParallelPixels() to where tiling breaks even on this device:
+     * one run's wake-up and join, timed here with the workers idle as they
+     * are between camera frames, against the share of a kernel costing
+     * `nanosPerPixel` that the other threads take off the caller. Takes
+     * about 15 ms; returns the new threshold.
+     */
+    long calibrate(double nanosPerPixel);
+
+    template <typename Fn>
+    void run(int tasks, Fn& fn) {
+        if (tasks <= 1 || mWorkers.empty()) {
+            for (int t = 0; t < tasks; ++t) fn(t);
+            return;
+        }
+        dispatch(tasks, [](void* context, int task) { (*static_cast<Fn*>(context))(task); }, &fn);
+    }
+
+    // Pool for the camera-frame kernels, sized to the big cores most SoCs
+    // have. Not calibrated here: the first use is usually on the camera
+    // thread, so the library's load hook calibrates it in the background.
+    static ThreadPool& frames();
+
+private:
+    using TaskFn = void (*)(void*, int);
+
+    std::vector<std::thread> mWorkers;
+    std::mutex mRunLock;            // one run at a time
+
+    std::mutex mLock;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    unsigned mGeneration = 0;
+    int mActive = 0;
+    bool mStop = false;
+
+    // Current run; written under mLock before mGeneration moves on
+    TaskFn mTask = nullptr;
+    void* mContext = nullptr;
+    int mTaskCount = 0;
+    std::atomic<int> mNext{0};
+
+    std::atomic<long> mMinParallelPixels;
+
+    void dispatch(int tasks, TaskFn task, void* context);
+    void workerLoop();
+    void runTasks();
+};
+
+// Upper bound on row tiles per reduction, so per-tile partials fit on the stack
+constexpr int kMaxRowTiles = 32;
+
+/**
+ * Tiles to split `rows` rows of `columns` pixels into: 1 (run inline) unless
+ * the work reaches the pool's minParallelPixels(), i.e. is large enough to
+ * pay for waking it.
+ */
+int rowTileCount(const ThreadPool* pool, int rows, int columns);
+
+/**
+ * Runs fn(tile, rowBegin, rowEnd) over `tiles` contiguous slices of rows
+ * [begin, end), on the pool when there is more than one. Callers keep one
+ * partial accumulator per tile and merge them in tile order, so the result
+ * does not depend on scheduling.
+ */
+template <typename Fn>
+void forEachRowTile(ThreadPool* pool, int tiles, int begin, int end, Fn fn) {
+    const int rows = end - begin;
+    auto tile = [&](int t) {
+        int first = begin + static_cast<int>(static_cast<long>(rows) * t / tiles);
+        int last = begin + static_cast<int>(static_cast<long>(rows) * (t + 1) / tiles);
+        fn(t, first, last);
+    };
+    if (pool && tiles > 1) {
+        pool->run(tiles, tile);
+    } else {
+        for (int t = 0; t < tiles; ++t) tile(t);
+    }
+}
+
+#endif //OJAS_THREAD_POOL_H
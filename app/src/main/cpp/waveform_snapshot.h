@@ -0,0 +1,83 @@
+// app/src/main/cpp/waveform_snapshot.h
+#ifndef OJAS_WAVEFORM_SNAPSHOT_H
+#define OJAS_WAVEFORM_SNAPSHOT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Published copy of a processor window for readers on other threads.
+ *
+ * Double-buffered sequence lock: publish() (one writer) fills the slot that
+ * does not hold the newest window, then bumps the published generation, so a
+ * reader only retries if the writer laps it and starts refilling the slot it
+ * is copying. Samples are atomics, which keeps a lapped copy from being a
+ * data race; they are stored with release and loaded with acquire, so a
+ * reader that copies any sample of a refill also sees that refill start,
+ * with no standalone fence (which ThreadSanitizer cannot check).
+ */
+class WaveformSnapshot {
+public:
+    explicit WaveformSnapshot(int capacity)
+            : mCapacity(std::max(1, capacity)),
+              mSlots(new std::atomic<float>[2 * static_cast<size_t>(mCapacity)]) {
+        for (int i = 0; i < 2 * mCapacity; ++i) mSlots[i].store(0.0f, std::memory_order_relaxed);
+    }
+
+    int capacity() const { return mCapacity; }
+
+    // Generation of the newest window; 0 until the first publish()
+    uint32_t sequence() const { return mPublished.load(std::memory_order_acquire); }
+
+    // Single writer. `count` is clamped to the capacity, keeping the newest samples.
+    void publish(const float* samples, int count) {
+        int skip = std::max(0, count - mCapacity);
+        samples += skip;
+        count = std::max(0, count - skip);
+        uint32_t generation = mStarted.load(std::memory_order_relaxed) + 1;
+        mStarted.store(generation, std::memory_order_relaxed);
+
+        std::atomic<float>* slot = mSlots.get() + (generation & 1) * static_cast<size_t>(mCapacity);
+        for (int i = 0; i < count; ++i) slot[i].store(samples[i], std::memory_order_release);
+        mCounts[generation & 1].store(count, std::memory_order_release);
+        mPublished.store(generation, std::memory_order_release);
+    }
+
+    // Copies the newest window (oldest first) into out, which has room for
+    // `room` floats, unless its generation equals `known`. Returns the
+    // generation; *count receives the number of samples now in out (or the
+    // window's size when the copy was skipped).
+    uint32_t read(float* out, int room, uint32_t known, int* count) const {
+        for (;;) {
+            uint32_t generation = mPublished.load(std::memory_order_acquire);
+            int total = mCounts[generation & 1].load(std::memory_order_acquire);
+            int size = std::max(0, std::min(room, total));
+            if (generation == known) {
+                *count = size;
+                return generation;
+            }
+            const std::atomic<float>* slot =
+                    mSlots.get() + (generation & 1) * static_cast<size_t>(mCapacity);
+            // Keep the newest samples if the caller's buffer is short
+            for (int i = 0; i < size; ++i) {
+                out[i] = slot[total - size + i].load(std::memory_order_acquire);
+            }
+            // A refill of this slot starts at generation + 2
+            if (mStarted.load(std::memory_order_relaxed) - generation < 2) {
+                *count = size;
+                return generation;
+            }
+        }
+    }
+
+private:
+    int mCapacity;
+    std::unique_ptr<std::atomic<float>[]> mSlots;   // slot g & 1 holds generation g
+    std::atomic<int> mCounts[2] = {{0}, {0}};
+    std::atomic<uint32_t> mStarted{0};
+    std::atomic<uint32_t> mPublished{0};
+};
+
+#endif //OJAS_WAVEFORM_SNAPSHOT_H
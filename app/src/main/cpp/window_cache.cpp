@@ -0,0 +1,230 @@
+// app/src/main/cpp/window_cache.cpp
+#include "window_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef USE_NEON
+#include <arm_neon.h>
+#elif defined(USE_SSE)
+#include <immintrin.h>
+#endif
+
+static void fillWindow(WindowType type, int n, float* out) {
+    if (n == 1) {
+        out[0] = 1.0f;
+        return;
+    }
+    const double denom = n - 1;
+    switch (type) {
+        case WindowType::Hamming:
+            for (int i = 0; i < n; ++i) {
+                out[i] = static_cast<float>(0.54 - 0.46 * cos(2.0 * M_PI * i / denom));
+            }
+            break;
+        case WindowType::Hann:
+            for (int i = 0; i < n; ++i) {
+                out[i] = static_cast<float>(0.5 - 0.5 * cos(2.0 * M_PI * i / denom));
+            }
+            break;
+        case WindowType::BlackmanHarris:
+            for (int i = 0; i < n; ++i) {
+                double x = 2.0 * M_PI * i / denom;
+                out[i] = static_cast<float>(0.35875 - 0.48829 * cos(x) +
+                                            0.14128 * cos(2.0 * x) - 0.01168 * cos(3.0 * x));
+            }
+            break;
+        case WindowType::Tukey: {
+            const double alpha = 0.5;
+            const double edge = alpha * denom / 2.0;
+            for (int i = 0; i < n; ++i) {
+                double d = std::min<double>(i, denom - i);
+                out[i] = d >= edge ? 1.0f
+                                   : static_cast<float>(0.5 * (1.0 - cos(M_PI * d / edge)));
+            }
+            break;
+        }
+        case WindowType::Dpss: {
+            computeDpss(n, 2.5, 1, out);
+            float peak = *std::max_element(out, out + n);
+            for (int i = 0; i < n; ++i) out[i] /= peak;
+            break;
+        }
+    }
+}
+
+// Rung i of the ladder from minLength to maxLength (ascending, distinct)
+static int rungCount(int minLength, int maxLength) {
+    return std::max(1, std::min(WindowTables::kRungs, maxLength - minLength + 1));
+}
+
+static int rungLength(int minLength, int maxLength, int rungs, int i) {
+    if (rungs == 1) return maxLength;
+    return minLength + static_cast<int>(static_cast<long>(maxLength - minLength) * i / (rungs - 1));
+}
+
+// Pad each rung to a multiple of 4 so vector loads past the tail stay in bounds
+static size_t rungFloats(int length, int tapers) {
+    return (static_cast<size_t>(length) * tapers + 3) & ~static_cast<size_t>(3);
+}
+
+size_t WindowTables::arenaBytes(int minLength, int maxLength, int tapers) {
+    maxLength = std::max(1, maxLength);
+    minLength = std::max(1, std::min(minLength, maxLength));
+    int rungs = rungCount(minLength, maxLength);
+    size_t bytes = 0;
+    for (int i = 0; i < rungs; ++i) {
+        bytes += Arena::bytesFor<float>(rungFloats(rungLength(minLength, maxLength, rungs, i), tapers));
+    }
+    return bytes;
+}
+
+WindowTables::WindowTables(int minLength, int maxLength, Arena& arena, int tapers)
+        : mTapers(std::max(1, tapers)) {
+    maxLength = std::max(1, maxLength);
+    minLength = std::max(1, std::min(minLength, maxLength));
+    mRungCount = rungCount(minLength, maxLength);
+    for (int i = 0; i < mRungCount; ++i) {
+        mLengths[i] = rungLength(minLength, maxLength, mRungCount, i);
+        size_t floats = rungFloats(mLengths[i], mTapers);
+        mTables[i] = arena.allocate<float>(floats);
+        std::fill(mTables[i], mTables[i] + floats, 0.0f);
+    }
+}
+
+void WindowTables::fill(WindowType type) {
+    for (int i = 0; i < mRungCount; ++i) {
+        for (int t = 0; t < mTapers; ++t) {
+            fillWindow(type, mLengths[i], mTables[i] + static_cast<size_t>(t) * mLengths[i]);
+        }
+    }
+}
+
+void WindowTables::fillDpss(double nw) {
+    for (int i = 0; i < mRungCount; ++i) {
+        computeDpss(mLengths[i], nw, mTapers, mTables[i]);
+    }
+}
+
+int WindowTables::length(int n) const {
+    int best = 0;
+    for (int i = 0; i < mRungCount && mLengths[i] <= n; ++i) best = mLengths[i];
+    return best;
+}
+
+const float* WindowTables::get(int length, int taper) const {
+    for (int i = 0; i < mRungCount; ++i) {
+        if (mLengths[i] == length) return mTables[i] + static_cast<size_t>(taper) * length;
+    }
+    return nullptr;
+}
+
+// --- DPSS (Slepian) tapers ---
+// The tapers are eigenvectors of the symmetric tridiagonal matrix
+//   diag[i]    = ((N - 1 - 2i) / 2)^2 * cos(2*pi*W)
+//   offdiag[i] = i * (N - i) / 2
+// with W = NW / N. Eigenvalues are isolated by Sturm-sequence bisection and
+// the vectors recovered with inverse iteration.
+
+// Number of eigenvalues of the tridiagonal matrix strictly below x
+static int sturmCount(const std::vector<double>& d, const std::vector<double>& e, double x) {
+    int count = 0;
+    double q = 1.0;
+    for (size_t i = 0; i < d.size(); ++i) {
+        double off = i > 0 ? e[i] * e[i] : 0.0;
+        q = d[i] - x - (i > 0 ? off / q : 0.0);
+        if (q == 0.0) q = -1e-300;
+        if (q < 0.0) ++count;
+    }
+    return count;
+}
+
+void computeDpss(int n, double nw, int count, float* out) {
+    const double w = nw / n;
+    std::vector<double> d(n), e(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        double c = (n - 1 - 2.0 * i) / 2.0;
+        d[i] = c * c * cos(2.0 * M_PI * w);
+        if (i > 0) e[i] = i * static_cast<double>(n - i) / 2.0;
+    }
+
+    // Gershgorin bounds
+    double lo = d[0], hi = d[0];
+    for (int i = 0; i < n; ++i) {
+        double r = fabs(e[i]) + (i + 1 < n ? fabs(e[i + 1]) : 0.0);
+        lo = std::min(lo, d[i] - r);
+        hi = std::max(hi, d[i] + r);
+    }
+
+    std::vector<double> v(n), b(n), cp(n), dp(n);
+    for (int k = 0; k < count; ++k) {
+        // k-th largest eigenvalue: exactly n - 1 - k eigenvalues lie below it
+        int target = n - 1 - k;
+        double a = lo, z = hi;
+        for (int it = 0; it < 200 && z - a > 1e-12 * std::max(1.0, fabs(z)); ++it) {
+            double mid = 0.5 * (a + z);
+            if (sturmCount(d, e, mid) > target) z = mid; else a = mid;
+        }
+        double lambda = 0.5 * (a + z) + 1e-10 * std::max(1.0, fabs(hi));
+
+        // Start vector with both symmetric and antisymmetric content
+        for (int i = 0; i < n; ++i) v[i] = 1.0 + (i - 0.5 * n) / n;
+
+        for (int it = 0; it < 4; ++it) {
+            // Solve (T - lambda I) x = v with the Thomas algorithm
+            for (int i = 0; i < n; ++i) b[i] = d[i] - lambda;
+            cp[0] = (n > 1 ? e[1] : 0.0) / b[0];
+            dp[0] = v[0] / b[0];
+            for (int i = 1; i < n; ++i) {
+                double m = b[i] - e[i] * cp[i - 1];
+                if (m == 0.0) m = 1e-300;
+                cp[i] = (i + 1 < n ? e[i + 1] : 0.0) / m;
+                dp[i] = (v[i] - e[i] * dp[i - 1]) / m;
+            }
+            v[n - 1] = dp[n - 1];
+            for (int i = n - 2; i >= 0; --i) v[i] = dp[i] - cp[i] * v[i + 1];
+
+            // Keep it orthogonal to the tapers already found
+            for (int j = 0; j < k; ++j) {
+                const float* prev = out + static_cast<size_t>(j) * n;
+                double dot = 0.0;
+                for (int i = 0; i < n; ++i) dot += v[i] * prev[i];
+                for (int i = 0; i < n; ++i) v[i] -= dot * prev[i];
+            }
+
+            double norm = 0.0;
+            for (int i = 0; i < n; ++i) norm += v[i] * v[i];
+            norm = sqrt(norm);
+            for (int i = 0; i < n; ++i) v[i] /= norm;
+        }
+
+        // Sign convention: symmetric tapers sum positive, antisymmetric
+        // tapers start with a positive lobe
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) s += (k % 2 == 0) ? v[i] : v[i] * (n - 1 - 2.0 * i);
+        double sign = s < 0.0 ? -1.0 : 1.0;
+
+        float* dst = out + static_cast<size_t>(k) * n;
+        for (int i = 0; i < n; ++i) dst[i] = static_cast<float>(sign * v[i]);
+    }
+}
+
+void removeMeanAndWindow(const float* in, const float* window, float mean, int n, float* out) {
+    int i = 0;
+#ifdef USE_NEON
+    float32x4_t vMean = vdupq_n_f32(mean);
+    for (; i <= n - 4; i += 4) {
+        float32x4_t x = vsubq_f32(vld1q_f32(in + i), vMean);
+        vst1q_f32(out + i, vmulq_f32(x, vld1q_f32(window + i)));
+    }
+#elif defined(USE_SSE)
+    __m128 vMean = _mm_set1_ps(mean);
+    for (; i <= n - 4; i += 4) {
+        __m128 x = _mm_sub_ps(_mm_loadu_ps(in + i), vMean);
+        _mm_storeu_ps(out + i, _mm_mul_ps(x, _mm_loadu_ps(window + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = (in[i] - mean) * window[i];
+    }
+}
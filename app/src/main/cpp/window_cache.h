@@ -0,0 +1,64 @@
+// app/src/main/cpp/window_cache.h
+#ifndef OJAS_WINDOW_CACHE_H
+#define OJAS_WINDOW_CACHE_H
+
+#include "arena.h"
+
+enum class WindowType {
+    Hamming = 0,
+    Hann = 1,
+    BlackmanHarris = 2,
+    Tukey = 3,      // alpha = 0.5
+    Dpss = 4        // zeroth Slepian sequence, NW = 2.5
+};
+
+/**
+ * Window tables owned by one processor, for the window lengths it analyses.
+ *
+ * While a window fills, its length changes with every sample, so a table per
+ * length would mean building tables on the analysis path. Lengths from
+ * minLength to maxLength are instead covered by a fixed ladder of up to
+ * kRungs lengths (the last one maxLength); the owner analyses the newest
+ * length(n) samples, the longest rung that fits. The tables live in the
+ * owner's arena and are filled up front, so lookups never lock or allocate.
+ */
+class WindowTables {
+public:
+    static constexpr int kRungs = 16;
+
+    // `tapers` tables per rung (more than one only for DPSS sets)
+    static size_t arenaBytes(int minLength, int maxLength, int tapers = 1);
+    WindowTables(int minLength, int maxLength, Arena& arena, int tapers = 1);
+
+    // (Re)fill every rung with one window; not for the real-time path
+    void fill(WindowType type);
+
+    // (Re)fill every rung with the first `tapers` unit-energy DPSS tapers
+    void fillDpss(double nw);
+
+    // Longest rung <= n, or 0 if n is below the shortest
+    int length(int n) const;
+
+    // Table for a rung returned by length()
+    const float* get(int length, int taper = 0) const;
+
+private:
+    int mRungCount = 0;
+    int mTapers;
+    int mLengths[kRungs];
+    float* mTables[kRungs];  // a rung's tapers one after another, padded to 4
+};
+
+/**
+ * First `count` discrete prolate spheroidal sequences of length n with
+ * time-bandwidth product nw, each normalized to unit energy and written
+ * one after another into out (count * n floats).
+ */
+void computeDpss(int n, double nw, int count, float* out);
+
+/**
+ * Fused analysis prep: out[i] = (in[i] - mean) * window[i] in one pass.
+ */
+void removeMeanAndWindow(const float* in, const float* window, float mean, int n, float* out);
+
+#endif //OJAS_WINDOW_CACHE_H
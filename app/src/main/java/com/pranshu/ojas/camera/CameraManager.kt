@@ -1,8 +1,6 @@
 package com.pranshu.ojas.camera
 
 import android.content.Context
-import android.graphics.Bitmap
-import android.graphics.Matrix
 import android.util.Log
 import androidx.camera.core.*
 import androidx.camera.lifecycle.ProcessCameraProvider
@@ -84,7 +82,7 @@ class CameraManager(
         // Image analysis use case for frame processing
         imageAnalysis = ImageAnalysis.Builder()
             .setTargetResolution(android.util.Size(640, 480))
-            .setOutputImageFormat(ImageAnalysis.OUTPUT_IMAGE_FORMAT_RGBA_8888)
+            .setOutputImageFormat(ImageAnalysis.OUTPUT_IMAGE_FORMAT_YUV_420_888)
             .setBackpressureStrategy(ImageAnalysis.STRATEGY_KEEP_ONLY_LATEST)
             .build()
             .also {
@@ -119,12 +117,18 @@ class CameraManager(
 
     private fun processFrame(imageProxy: ImageProxy) {
         try {
-            // Convert ImageProxy to Bitmap
-            val bitmap = imageProxy.toBitmap()
-
-            // Process with face tracker
             val timestamp = System.currentTimeMillis()
-            faceTracker?.processFrame(bitmap, timestamp)
+            faceTracker?.let { tracker ->
+                // Signal: ROI colour straight from the YUV planes with the latest landmarks
+                tracker.processSignalFrame(imageProxy)
+
+                // Landmarks: only convert a frame when the landmarker can take it
+                if (tracker.isReadyForFrame()) {
+                    tracker.processFrame(
+                        imageProxy.toBitmap(), imageProxy.imageInfo.rotationDegrees, timestamp
+                    )
+                }
+            }
 
             // FPS tracking
             frameCount++
@@ -143,21 +147,6 @@ class CameraManager(
         }
     }
 
-    private fun ImageProxy.toBitmap(): Bitmap {
-        val buffer = planes[0].buffer
-        val bytes = ByteArray(buffer.remaining())
-        buffer.get(bytes)
-
-        val bitmap = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888)
-        bitmap.copyPixelsFromBuffer(java.nio.ByteBuffer.wrap(bytes))
-
-        // Rotate bitmap to correct orientation
-        val matrix = Matrix()
-        matrix.postRotate(imageInfo.rotationDegrees.toFloat())
-
-        return Bitmap.createBitmap(bitmap, 0, 0, width, height, matrix, true)
-    }
-
     /**
      * Switch between front and back camera
      */
@@ -0,0 +1,94 @@
+package com.pranshu.ojas.core
+
+import android.util.Log
+
+/**
+ * JNI wrapper for the native blind-source-separation estimator: PCA
+ * whitening and FastICA over the windowed R, G, B ROI means, with the heart
+ * rate taken from the most pulse-like component. An alternative to the
+ * CHROM / POS stages when the colour mix of the pulse is not known.
+ */
+class NativeBssProcessor(
+    private val bufferSize: Int = 300,  // ~10 seconds at 30fps
+    private val samplingRate: Float = 30f
+) {
+    private var nativeHandle: Long = 0
+
+    init {
+        System.loadLibrary("ojas")
+        nativeHandle = nativeInit(bufferSize, samplingRate)
+        Log.d(TAG, "NativeBssProcessor initialized: handle=$nativeHandle")
+    }
+
+    /**
+     * Add one frame's ROI mean colour (0 - 255)
+     */
+    fun addFrame(r: Float, g: Float, b: Float) {
+        if (nativeHandle != 0L) {
+            addFrame(nativeHandle, r, g, b)
+        }
+    }
+
+    /**
+     * Separate the current window and return the heart rate in BPM
+     * (0 until ~3 s of frames are in)
+     */
+    fun computeHeartRate(): Float {
+        return if (nativeHandle != 0L) {
+            getHeartRate(nativeHandle)
+        } else {
+            0f
+        }
+    }
+
+    /**
+     * Copy the selected component of the last computeHeartRate() (unit
+     * variance, oldest first) into out; returns the number of samples written
+     */
+    fun getComponent(out: FloatArray): Int {
+        return if (nativeHandle != 0L) getComponent(nativeHandle, out) else 0
+    }
+
+    /**
+     * Get current sample count
+     */
+    fun getCurrentSampleCount(): Int {
+        return if (nativeHandle != 0L) {
+            getSampleCount(nativeHandle)
+        } else {
+            0
+        }
+    }
+
+    /**
+     * Reset the window and the unmixing matrix
+     */
+    fun reset() {
+        if (nativeHandle != 0L) {
+            reset(nativeHandle)
+        }
+    }
+
+    /**
+     * Release native resources
+     */
+    fun release() {
+        if (nativeHandle != 0L) {
+            nativeRelease(nativeHandle)
+            nativeHandle = 0
+        }
+    }
+
+    // Native method declarations
+    private external fun nativeInit(bufferSize: Int, samplingRate: Float): Long
+    private external fun nativeRelease(handle: Long)
+    private external fun addFrame(handle: Long, r: Float, g: Float, b: Float)
+    private external fun getHeartRate(handle: Long): Float
+    private external fun getComponent(handle: Long, out: FloatArray): Int
+    private external fun getSampleCount(handle: Long): Int
+    private external fun reset(handle: Long)
+
+    companion object {
+        private const val TAG = "NativeBssProcessor"
+    }
+}
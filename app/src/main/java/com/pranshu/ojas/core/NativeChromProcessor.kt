@@ -0,0 +1,62 @@
+package com.pranshu.ojas.core
+
+import android.util.Log
+
+/**
+ * JNI wrapper for the native CHROM stage: turns per-frame ROI mean colours
+ * into chrominance pulse samples, which are far less sensitive to lighting
+ * changes and motion than raw green. Feed its output to NativeSignalProcessor
+ * (or NativeMultiChannelProcessor) instead of the green mean.
+ *
+ * Not thread-safe: call process() from one thread at a time.
+ */
+class NativeChromProcessor(
+    val channelCount: Int = 1,
+    samplingRate: Float = 30f,
+    windowSeconds: Float = 1.6f  // normalisation / alpha window
+) {
+    private var nativeHandle: Long = 0
+
+    init {
+        System.loadLibrary("ojas")
+        nativeHandle = nativeInit(channelCount, samplingRate, windowSeconds)
+        Log.d(TAG, "NativeChromProcessor initialized: channels=$channelCount handle=$nativeHandle")
+    }
+
+    /**
+     * One frame: rgb[3c .. 3c + 2] is ROI c's mean R, G, B (0 - 255).
+     * Writes one pulse sample per ROI into out; false if nothing was written.
+     */
+    fun process(rgb: FloatArray, out: FloatArray): Boolean {
+        return nativeHandle != 0L && process(nativeHandle, rgb, out)
+    }
+
+    /**
+     * Restart the running means and filters, e.g. after the face was lost
+     */
+    fun reset() {
+        if (nativeHandle != 0L) {
+            reset(nativeHandle)
+        }
+    }
+
+    /**
+     * Release native resources
+     */
+    fun release() {
+        if (nativeHandle != 0L) {
+            nativeRelease(nativeHandle)
+            nativeHandle = 0
+        }
+    }
+
+    // Native method declarations
+    private external fun nativeInit(channels: Int, samplingRate: Float, windowSeconds: Float): Long
+    private external fun nativeRelease(handle: Long)
+    private external fun process(handle: Long, rgb: FloatArray, out: FloatArray): Boolean
+    private external fun reset(handle: Long)
+
+    companion object {
+        private const val TAG = "NativeChromProcessor"
+    }
+}
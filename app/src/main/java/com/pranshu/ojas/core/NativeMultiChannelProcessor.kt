@@ -0,0 +1,86 @@
+package com.pranshu.ojas.core
+
+import android.util.Log
+
+/**
+ * JNI wrapper for the native multi-channel processor: one heart-rate
+ * estimate per channel (forehead / cheek ROIs, several faces) from a single
+ * native object, analysed in one batched pass.
+ */
+class NativeMultiChannelProcessor(
+    val channelCount: Int,
+    private val bufferSize: Int = 300,  // ~10 seconds at 30fps
+    private val samplingRate: Float = 30f
+) {
+    private var nativeHandle: Long = 0
+
+    init {
+        System.loadLibrary("ojas")
+        nativeHandle = nativeInit(channelCount, bufferSize, samplingRate)
+        Log.d(TAG, "NativeMultiChannelProcessor initialized: channels=$channelCount handle=$nativeHandle")
+    }
+
+    /**
+     * Add one frame: values[c] is channel c's sample (size >= channelCount)
+     */
+    fun addFrame(values: FloatArray) {
+        if (nativeHandle != 0L) {
+            addFrame(nativeHandle, values)
+        }
+    }
+
+    /**
+     * Heart rate in BPM per channel (0 while the window fills or a channel has no lock).
+     * Pass `out` to reuse an array across calls.
+     */
+    fun computeHeartRates(out: FloatArray = FloatArray(channelCount)): FloatArray {
+        if (nativeHandle != 0L) {
+            getHeartRates(nativeHandle, out)
+        } else {
+            out.fill(0f)
+        }
+        return out
+    }
+
+    /**
+     * Get current sample count (shared by all channels)
+     */
+    fun getCurrentSampleCount(): Int {
+        return if (nativeHandle != 0L) {
+            getSampleCount(nativeHandle)
+        } else {
+            0
+        }
+    }
+
+    /**
+     * Reset all channels
+     */
+    fun reset() {
+        if (nativeHandle != 0L) {
+            reset(nativeHandle)
+        }
+    }
+
+    /**
+     * Release native resources
+     */
+    fun release() {
+        if (nativeHandle != 0L) {
+            nativeRelease(nativeHandle)
+            nativeHandle = 0
+        }
+    }
+
+    // Native method declarations
+    private external fun nativeInit(channels: Int, bufferSize: Int, samplingRate: Float): Long
+    private external fun nativeRelease(handle: Long)
+    private external fun addFrame(handle: Long, values: FloatArray)
+    private external fun getHeartRates(handle: Long, out: FloatArray)
+    private external fun getSampleCount(handle: Long): Int
+    private external fun reset(handle: Long)
+
+    companion object {
+        private const val TAG = "NativeMultiChannelProcessor"
+    }
+}
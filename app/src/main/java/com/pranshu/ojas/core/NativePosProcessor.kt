@@ -0,0 +1,67 @@
+package com.pranshu.ojas.core
+
+import android.util.Log
+
+/**
+ * JNI wrapper for the native POS (plane-orthogonal-to-skin) stage: turns
+ * per-frame ROI mean colours into pulse samples, overlap-added over short
+ * windows. More tolerant of motion and specular changes than CHROM.
+ *
+ * Each sample belongs to the frame latencyFrames ago (one window, ~1.6 s).
+ * Not thread-safe: call process() from one thread at a time.
+ */
+class NativePosProcessor(
+    val channelCount: Int = 1,
+    samplingRate: Float = 30f,
+    windowSeconds: Float = 1.6f
+) {
+    private var nativeHandle: Long = 0
+
+    val latencyFrames: Int
+
+    init {
+        System.loadLibrary("ojas")
+        nativeHandle = nativeInit(channelCount, samplingRate, windowSeconds)
+        latencyFrames = getLatencyFrames(nativeHandle)
+        Log.d(TAG, "NativePosProcessor initialized: channels=$channelCount handle=$nativeHandle")
+    }
+
+    /**
+     * One frame: rgb[3c .. 3c + 2] is ROI c's mean R, G, B (0 - 255).
+     * Writes one pulse sample per ROI into out; false while the first
+     * window fills (nothing written).
+     */
+    fun process(rgb: FloatArray, out: FloatArray): Boolean {
+        return nativeHandle != 0L && process(nativeHandle, rgb, out)
+    }
+
+    /**
+     * Drop the window, e.g. after the face was lost
+     */
+    fun reset() {
+        if (nativeHandle != 0L) {
+            reset(nativeHandle)
+        }
+    }
+
+    /**
+     * Release native resources
+     */
+    fun release() {
+        if (nativeHandle != 0L) {
+            nativeRelease(nativeHandle)
+            nativeHandle = 0
+        }
+    }
+
+    // Native method declarations
+    private external fun nativeInit(channels: Int, samplingRate: Float, windowSeconds: Float): Long
+    private external fun nativeRelease(handle: Long)
+    private external fun getLatencyFrames(handle: Long): Int
+    private external fun process(handle: Long, rgb: FloatArray, out: FloatArray): Boolean
+    private external fun reset(handle: Long)
+
+    companion object {
+        private const val TAG = "NativePosProcessor"
+    }
+}
@@ -0,0 +1,99 @@
+package com.pranshu.ojas.core
+
+import android.graphics.Bitmap
+import androidx.camera.core.ImageProxy
+import java.nio.ByteBuffer
+
+/**
+ * JNI entry points for native ROI extraction: per-ROI colour statistics over
+ * convex landmark polygons, computed in one call straight from the frame's
+ * pixels and packed into one caller-owned array.
+ */
+object NativeRoiExtractor {
+
+    /** Values written per ROI by computeRoiStats, in this order */
+    const val VALUES_PER_ROI = 7
+    const val MEAN_R = 0
+    const val MEAN_G = 1
+    const val MEAN_B = 2
+    const val VAR_R = 3
+    const val VAR_G = 4
+    const val VAR_B = 5
+    const val PIXEL_COUNT = 6
+
+    /** ROIs measured per call (kMaxRois); further polygons are ignored */
+    const val MAX_ROIS = 8
+
+    init {
+        System.loadLibrary("ojas")
+    }
+
+    /**
+     * ROI i is the convex hull of the landmarks
+     * polygonIndices[polygonStarts[i] until polygonStarts[i + 1]].
+     * `landmarks` holds normalized (x, y) pairs; `bitmap` must be ARGB_8888.
+     * Returns the number of ROIs written to `out` (VALUES_PER_ROI floats each,
+     * at most MAX_ROIS).
+     */
+    external fun computeRoiStats(
+        bitmap: Bitmap,
+        landmarks: FloatArray,
+        polygonIndices: IntArray,
+        polygonStarts: IntArray,
+        out: FloatArray
+    ): Int
+
+    /**
+     * Same as above, read in place from a YUV_420_888 ImageProxy. Landmarks
+     * are in upright coordinates of the whole frame; the image's
+     * rotationDegrees maps them back onto the sensor-oriented planes, and
+     * only pixels inside its cropRect are read.
+     *
+     * With skinOnly, each ROI keeps only pixels classified as skin (YCbCr
+     * box with specular and low-saturation rejection) in the same pass, and
+     * PIXEL_COUNT is the number of skin pixels.
+     */
+    fun computeRoiStats(
+        image: ImageProxy,
+        landmarks: FloatArray,
+        polygonIndices: IntArray,
+        polygonStarts: IntArray,
+        out: FloatArray,
+        skinOnly: Boolean = false
+    ): Int {
+        val planes = image.planes
+        if (planes.size < 3) return 0
+        val crop = image.cropRect
+        return computeRoiStatsYuv(
+            planes[0].buffer, planes[1].buffer, planes[2].buffer,
+            image.width, image.height,
+            planes[0].rowStride, planes[0].pixelStride,
+            planes[1].rowStride, planes[1].pixelStride,
+            image.imageInfo.rotationDegrees,
+            crop.left, crop.top, crop.right, crop.bottom, skinOnly,
+            landmarks, polygonIndices, polygonStarts, out
+        )
+    }
+
+    private external fun computeRoiStatsYuv(
+        yBuffer: ByteBuffer,
+        uBuffer: ByteBuffer,
+        vBuffer: ByteBuffer,
+        width: Int,
+        height: Int,
+        yRowStride: Int,
+        yPixelStride: Int,
+        uvRowStride: Int,
+        uvPixelStride: Int,
+        rotationDegrees: Int,
+        cropLeft: Int,
+        cropTop: Int,
+        cropRight: Int,
+        cropBottom: Int,
+        skinOnly: Boolean,
+        landmarks: FloatArray,
+        polygonIndices: IntArray,
+        polygonStarts: IntArray,
+        out: FloatArray
+    ): Int
+}
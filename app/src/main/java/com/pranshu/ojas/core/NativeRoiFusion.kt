@@ -0,0 +1,78 @@
+package com.pranshu.ojas.core
+
+import android.util.Log
+
+/**
+ * JNI wrapper for the native ROI fusion stage: merges one pulse trace per
+ * ROI (e.g. NativePosProcessor lanes for forehead and cheeks) into a single
+ * trace, weighting each ROI by its in-band SNR so a shadowed or moving ROI
+ * does not pollute the others.
+ *
+ * SNRs come from one batched spectrum over all ROIs, refreshed once a second.
+ * Not thread-safe: call addFrame() from one thread at a time.
+ */
+class NativeRoiFusion(
+    val channelCount: Int,
+    bufferSize: Int = 300,
+    samplingRate: Float = 30f
+) {
+    private var nativeHandle: Long = 0
+
+    init {
+        System.loadLibrary("ojas")
+        nativeHandle = nativeInit(channelCount, bufferSize, samplingRate)
+        Log.d(TAG, "NativeRoiFusion initialized: channels=$channelCount handle=$nativeHandle")
+    }
+
+    /**
+     * One frame: values[c] is ROI c's pulse sample. Returns the fused sample.
+     */
+    fun addFrame(values: FloatArray): Float {
+        return if (nativeHandle != 0L) addFrame(nativeHandle, values) else 0f
+    }
+
+    /**
+     * Current per-ROI weights into out; returns the number written
+     */
+    fun getWeights(out: FloatArray): Int {
+        return if (nativeHandle != 0L) getWeights(nativeHandle, out) else 0
+    }
+
+    /**
+     * Per-ROI in-band SNR behind the weights into out; returns the number written
+     */
+    fun getSnr(out: FloatArray): Int {
+        return if (nativeHandle != 0L) getSnr(nativeHandle, out) else 0
+    }
+
+    /**
+     * Drop the traces and fall back to equal weights
+     */
+    fun reset() {
+        if (nativeHandle != 0L) {
+            reset(nativeHandle)
+        }
+    }
+
+    /**
+     * Release native resources
+     */
+    fun release() {
+        if (nativeHandle != 0L) {
+            nativeRelease(nativeHandle)
+            nativeHandle = 0
+        }
+    }
+
+    // Native method declarations
+    private external fun nativeInit(channels: Int, bufferSize: Int, samplingRate: Float): Long
+    private external fun nativeRelease(handle: Long)
+    private external fun addFrame(handle: Long, values: FloatArray): Float
+    private external fun getWeights(handle: Long, out: FloatArray): Int
+    private external fun getSnr(handle: Long, out: FloatArray): Int
+    private external fun reset(handle: Long)
+
+    companion object {
+        private const val TAG = "NativeRoiFusion"
+    }
+}
@@ -1,6 +1,9 @@
 package com.pranshu.ojas.core
 
+import android.os.Build
 import android.util.Log
+import java.nio.ByteBuffer
+import java.nio.FloatBuffer
 
 /**
  * JNI wrapper for C++ signal processing with Arm Neon optimization
@@ -11,6 +14,18 @@ class NativeSignalProcessor(
 ) {
     private var nativeHandle: Long = 0
 
+    // Shared-memory input queue, see enableSharedInput()
+    private var sampleRing: SampleRing? = null
+
+    @Volatile
+    private var workerRunning = false
+
+    /**
+     * Samples addSample() dropped because the shared ring was full
+     */
+    var droppedSamples = 0L
+        private set
+
     init {
         System.loadLibrary("ojas")
         nativeHandle = nativeInit(bufferSize, samplingRate)
@@ -18,11 +33,85 @@ class NativeSignalProcessor(
     }
 
     /**
-     * Add a new green channel sample to the circular buffer
+     * Route addSample() through a shared-memory ring instead of one JNI call per
+     * sample. Queued samples are applied natively on the next query (heart rate,
+     * buffer, sample count, ...) or by the analysis worker; samples offered while
+     * the ring is full are dropped (see droppedSamples). Requires API 33; returns
+     * false if unavailable. addSample() must then be called from one thread only.
+     */
+    fun enableSharedInput(capacity: Int = 256): Boolean {
+        if (nativeHandle == 0L || Build.VERSION.SDK_INT < Build.VERSION_CODES.TIRAMISU) return false
+        if (sampleRing != null) return true
+        val ring = SampleRing(capacity)
+        if (!attachSampleRing(nativeHandle, ring.buffer)) return false
+        sampleRing = ring
+        Log.d(TAG, "Shared input ring attached: capacity=${ring.capacity}")
+        return true
+    }
+
+    /**
+     * Move analysis onto a native worker thread that drains queued samples and
+     * recomputes heart rate / respiration every [intervalMs]. While it runs,
+     * computeHeartRate(), computeRespirationRate(), getCurrentSampleCount() and
+     * the fps/jitter getters return its latest published result without blocking.
+     * Calling again only changes the interval.
+     */
+    fun startAnalysisWorker(intervalMs: Int = 1000) {
+        if (nativeHandle != 0L) {
+            startWorker(nativeHandle, intervalMs)
+            workerRunning = true
+        }
+    }
+
+    fun stopAnalysisWorker() {
+        if (nativeHandle != 0L) {
+            stopWorker(nativeHandle)
+            workerRunning = false
+        }
+    }
+
+    /**
+     * Latest worker result, or null if no worker is running
+     */
+    fun getLatestResult(): AnalysisResult? {
+        if (nativeHandle == 0L || !workerRunning) return null
+        val packed = FloatArray(RESULT_SIZE)
+        if (!getWorkerResult(nativeHandle, packed)) return null
+        return AnalysisResult(
+            heartRate = packed[0],
+            respirationRate = packed[1],
+            peakToNoise = packed[2],
+            effectiveFps = packed[3],
+            jitterMs = packed[4],
+            sampleCount = packed[5].toInt(),
+            sequence = packed[6].toInt()
+        )
+    }
+
+    /**
+     * Add a new green channel sample to the circular buffer. timestamp is in
+     * milliseconds; pass the frame's capture time (ImageInfo.timestamp) so the
+     * resampler sees the camera's real frame spacing.
      */
     fun addSample(greenValue: Float, timestamp: Long = System.currentTimeMillis()) {
+        if (nativeHandle == 0L) return
+        val ring = sampleRing
+        if (ring != null && Build.VERSION.SDK_INT >= Build.VERSION_CODES.TIRAMISU) {
+            // Full means nothing has drained for a whole ring; drop the sample
+            // rather than drain here, which would wait for a running analysis
+            // on the camera thread
+            if (!ring.offer(greenValue, timestamp)) droppedSamples++
+            return
+        }
+        addSample(nativeHandle, greenValue, timestamp)
+    }
+
+    /**
+     * Add a batch of samples with a single JNI call
+     */
+    fun addSamples(greenValues: FloatArray, timestamps: LongArray) {
         if (nativeHandle != 0L) {
-            addSample(nativeHandle, greenValue, timestamp)
+            addSamples(nativeHandle, greenValues, timestamps)
         }
     }
 
@@ -38,6 +127,124 @@ class NativeSignalProcessor(
         }
     }
 
+    /**
+     * Compute respiration rate from the same trace
+     * Returns breaths per minute (0 until ~30 s of samples are in)
+     */
+    fun computeRespirationRate(): Float {
+        return if (nativeHandle != 0L) {
+            getRespirationRate(nativeHandle)
+        } else {
+            0f
+        }
+    }
+
+    /**
+     * Select the spectral back-end used by computeHeartRate().
+     * SLIDING_DFT keeps the HR-band bins up to date on every sample, so
+     * computeHeartRate() becomes cheap enough to call once per frame.
+     */
+    fun setSpectralEngine(engine: SpectralEngine) {
+        if (nativeHandle != 0L) {
+            setSpectralEngine(nativeHandle, engine.nativeId)
+        }
+    }
+
+    /**
+     * Turn respiration off for traces band-passed to the pulse band (CHROM,
+     * POS), which carry no breathing; computeRespirationRate() and the
+     * worker's respirationRate then report 0. On by default.
+     */
+    fun setRespirationEnabled(enabled: Boolean) {
+        if (nativeHandle != 0L) {
+            setRespirationEnabled(nativeHandle, enabled)
+        }
+    }
+
+    /**
+     * Select the taper applied before the batch FFT
+     */
+    fun setWindowType(type: WindowType) {
+        if (nativeHandle != 0L) {
+            setWindowType(nativeHandle, type.nativeId)
+        }
+    }
+
+    /**
+     * Zero-padded length of the batch FFT (clamped to at least the buffer size)
+     */
+    fun setFftLength(length: Int) {
+        if (nativeHandle != 0L) {
+            setFftLength(nativeHandle, length)
+        }
+    }
+
+    /**
+     * Frequency grid spacing of the ZOOM_FFT engine, in BPM
+     */
+    fun setZoomResolution(bpmStep: Float) {
+        if (nativeHandle != 0L) {
+            setZoomResolution(nativeHandle, bpmStep)
+        }
+    }
+
+    /**
+     * Sub-bin refinement applied to the detected spectral peak
+     */
+    fun setPeakInterpolation(mode: PeakInterpolation) {
+        if (nativeHandle != 0L) {
+            setPeakInterpolation(nativeHandle, mode.nativeId)
+        }
+    }
+
+    /**
+     * Segment overlap (0 - 0.9) used by the WELCH engine
+     */
+    fun setWelchOverlap(overlap: Float) {
+        if (nativeHandle != 0L) {
+            setWelchOverlap(nativeHandle, overlap)
+        }
+    }
+
+    /**
+     * How sample timestamps are mapped onto the uniform analysis grid
+     */
+    fun setResampleMode(mode: ResampleMode) {
+        if (nativeHandle != 0L) {
+            setResampleMode(nativeHandle, mode.nativeId)
+        }
+    }
+
+    /**
+     * Frame rate measured from sample timestamps
+     */
+    fun getEffectiveFps(): Float {
+        return if (nativeHandle != 0L) getEffectiveFps(nativeHandle) else 0f
+    }
+
+    /**
+     * Standard deviation of the frame interval in milliseconds
+     */
+    fun getJitterMs(): Float {
+        return if (nativeHandle != 0L) getJitterMs(nativeHandle) else 0f
+    }
+
+    /**
+     * Copy the newest window (oldest first) into [out], a direct FloatBuffer such as
+     * ByteBuffer.allocateDirect(n * 4).order(ByteOrder.nativeOrder()).asFloatBuffer(),
+     * unless it is unchanged since [knownSequence]. On return out's position is 0 and
+     * its limit is the sample count. Returns the window's sequence number; pass it back
+     * to skip unchanged windows. Nothing is allocated on either side, and with the
+     * analysis worker running this never waits for it.
+     */
+    fun readWaveform(out: FloatBuffer, knownSequence: Int = -1): Int {
+        if (nativeHandle == 0L || !out.isDirect) return knownSequence
+        val packed = readWaveform(nativeHandle, out, knownSequence)
+        out.limit((packed and 0xFFFFFFFFL).toInt())
+        out.position(0)
+        return (packed ushr 32).toInt()
+    }
+
     /**
      * Get the current signal buffer for visualization
      */
@@ -49,10 +256,40 @@ class NativeSignalProcessor(
         }
     }
 
+    /**
+     * Average of byte `channel` over a rectangle of a strided image plane, read in place
+     * from a direct ByteBuffer (e.g. ImageProxy.planes[0].buffer with its rowStride and
+     * pixelStride). Nothing is copied, so the cost scales with the rectangle's pixels.
+     * Returns 0 if the buffer is not direct or too small for the given geometry.
+     */
+    fun computeChannelAverage(
+        buffer: ByteBuffer,
+        width: Int,
+        height: Int,
+        rowStride: Int,
+        pixelStride: Int,
+        channel: Int = 1,
+        left: Int = 0,
+        top: Int = 0,
+        roiWidth: Int = width,
+        roiHeight: Int = height
+    ): Float {
+        if (!buffer.isDirect) return 0f
+        return computeChannelAverageDirect(
+            buffer, width, height, rowStride, pixelStride, channel, left, top, roiWidth, roiHeight
+        )
+    }
+
     /**
      * Get current sample count
      */
     fun getCurrentSampleCount(): Int {
+        // With the shared ring this is answered without a JNI call: the window size
+        // at the last drain plus what is still queued (exact unless resampling)
+        val ring = sampleRing
+        if (nativeHandle != 0L && ring != null && Build.VERSION.SDK_INT >= Build.VERSION_CODES.TIRAMISU) {
+            return minOf(bufferSize, ring.drainedWindowSize() + ring.pending())
+        }
         return if (nativeHandle != 0L) {
             getSampleCount(nativeHandle)
         } else {
@@ -74,6 +311,10 @@ class NativeSignalProcessor(
      */
     fun release() {
         if (nativeHandle != 0L) {
+            if (workerRunning) stopWorker(nativeHandle)
+            workerRunning = false
+            if (sampleRing != null) detachSampleRing(nativeHandle)
+            sampleRing = null
             nativeRelease(nativeHandle)
             nativeHandle = 0
         }
@@ -83,12 +324,90 @@ class NativeSignalProcessor(
     private external fun nativeInit(bufferSize: Int, samplingRate: Float): Long
     private external fun nativeRelease(handle: Long)
     private external fun addSample(handle: Long, greenValue: Float, timestamp: Long)
+    private external fun addSamples(handle: Long, greenValues: FloatArray, timestamps: LongArray)
+    private external fun attachSampleRing(handle: Long, buffer: ByteBuffer): Boolean
+    private external fun detachSampleRing(handle: Long)
+    private external fun startWorker(handle: Long, intervalMs: Int)
+    private external fun stopWorker(handle: Long)
+    private external fun getWorkerResult(handle: Long, out: FloatArray): Boolean
     private external fun getHeartRate(handle: Long): Float
+    private external fun getRespirationRate(handle: Long): Float
+    private external fun setSpectralEngine(handle: Long, engine: Int)
+    private external fun setWindowType(handle: Long, type: Int)
+    private external fun setRespirationEnabled(handle: Long, enabled: Boolean)
+    private external fun setFftLength(handle: Long, length: Int)
+    private external fun setZoomResolution(handle: Long, bpmStep: Float)
+    private external fun setPeakInterpolation(handle: Long, mode: Int)
+    private external fun setWelchOverlap(handle: Long, overlap: Float)
+    private external fun setResampleMode(handle: Long, mode: Int)
+    private external fun getEffectiveFps(handle: Long): Float
+    private external fun getJitterMs(handle: Long): Float
     private external fun getBuffer(handle: Long): FloatArray?
+    private external fun readWaveform(handle: Long, out: FloatBuffer, knownSequence: Int): Long
     private external fun getSampleCount(handle: Long): Int
+    private external fun computeChannelAverageDirect(
+        buffer: ByteBuffer, width: Int, height: Int, rowStride: Int, pixelStride: Int,
+        channel: Int, left: Int, top: Int, roiWidth: Int, roiHeight: Int
+    ): Float
     private external fun reset(handle: Long)
 
     companion object {
         private const val TAG = "NativeSignalProcessor"
+
+        // Floats per packed result (kPackedAnalysisResult in analysis_worker.h)
+        private const val RESULT_SIZE = 7
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Snapshot published by the native analysis worker
+ */
+data class AnalysisResult(
+    val heartRate: Float,
+    val respirationRate: Float,
+    val peakToNoise: Float,  // HR peak / mean band magnitude
+    val effectiveFps: Float,
+    val jitterMs: Float,
+    val sampleCount: Int,
+    val sequence: Int        // analyses completed since the worker started
+)
+
+/**
+ * Mirrors the native SpectralEngine enum in signal_processor.h
+ */
+enum class SpectralEngine(val nativeId: Int) {
+    BATCH_FFT(0),
+    SLIDING_DFT(1),
+    ZOOM_FFT(2),
+    WELCH(3),
+    MULTITAPER(4)
+}
+
+/**
+ * Mirrors the native PeakInterpolation enum in signal_processor.h
+ */
+enum class PeakInterpolation(val nativeId: Int) {
+    NONE(0),
+    PARABOLIC(1),
+    GAUSSIAN(2)
+}
+
+/**
+ * Mirrors the native ResampleMode enum in resampler.h
+ */
+enum class ResampleMode(val nativeId: Int) {
+    OFF(0),
+    LINEAR(1),
+    CUBIC(2)
+}
+
+/**
+ * Mirrors the native WindowType enum in window_cache.h
+ */
+enum class WindowType(val nativeId: Int) {
+    HAMMING(0),
+    HANN(1),
+    BLACKMAN_HARRIS(2),
+    TUKEY(3),
+    DPSS(4)
+}
@@ -0,0 +1,68 @@
+package com.pranshu.ojas.core
+
+import android.os.Build
+import androidx.annotation.RequiresApi
+import java.lang.invoke.MethodHandles
+import java.lang.invoke.VarHandle
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Producer side of the native SampleRing (sample_ring.h): a single-producer /
+ * single-consumer queue of (value, timestamp) records in a direct ByteBuffer.
+ * Records are written here without any JNI call; native code drains them the
+ * next time the processor is queried.
+ *
+ * Only one thread may call offer().
+ */
+@RequiresApi(Build.VERSION_CODES.TIRAMISU)
+internal class SampleRing(requestedCapacity: Int) {
+
+    // Power of two, so indices can be masked
+    val capacity: Int = Integer.highestOneBit(requestedCapacity.coerceAtLeast(2))
+
+    val buffer: ByteBuffer = ByteBuffer
+        .allocateDirect(HEADER_BYTES + capacity * RECORD_BYTES)
+        .order(ByteOrder.nativeOrder())
+
+    private var writeIndex = 0
+
+    /**
+     * Queue one sample; false if the ring is full (the consumer has fallen
+     * a whole ring behind)
+     */
+    fun offer(value: Float, timestamp: Long): Boolean {
+        val readIndex = INDEX.getAcquire(buffer, READ_OFFSET) as Int
+        if (writeIndex - readIndex >= capacity) return false
+
+        val offset = HEADER_BYTES + (writeIndex and (capacity - 1)) * RECORD_BYTES
+        buffer.putLong(offset, timestamp)
+        buffer.putFloat(offset + 8, value)
+        writeIndex++
+        // Release: the record is visible before the new index
+        INDEX.setRelease(buffer, WRITE_OFFSET, writeIndex)
+        return true
+    }
+
+    /**
+     * Records written but not yet drained by native code
+     */
+    fun pending(): Int = writeIndex - (INDEX.getAcquire(buffer, READ_OFFSET) as Int)
+
+    /**
+     * Native window size as of the last drain
+     */
+    fun drainedWindowSize(): Int = INDEX.getAcquire(buffer, COUNT_OFFSET) as Int
+
+    companion object {
+        // Must match sample_ring.h
+        private const val WRITE_OFFSET = 0
+        private const val READ_OFFSET = 64
+        private const val COUNT_OFFSET = 68
+        private const val HEADER_BYTES = 128
+        private const val RECORD_BYTES = 16
+
+        private val INDEX: VarHandle =
+            MethodHandles.byteBufferViewVarHandle(IntArray::class.java, ByteOrder.nativeOrder())
+    }
+}
@@ -51,7 +51,7 @@ fun MainScreen() {
 
     // --- State Collection ---
     val heartRate by viewModel.heartRate.collectAsState()
-    val signalBuffer by viewModel.signalBuffer.collectAsState()
+    val graphVersion by viewModel.graphVersion.collectAsState()
     val status by viewModel.status.collectAsState()
     val confidence by viewModel.confidence.collectAsState()
     val stressLevel by viewModel.stressLevel.collectAsState()
@@ -287,7 +287,7 @@ fun MainScreen() {
                 Column(modifier = Modifier.padding(12.dp)) {
                     Text("Live Pulse Signal", color = Color.Gray, fontSize = 12.sp)
                     Spacer(modifier = Modifier.height(8.dp))
-                    GraphContent(signalBuffer, confidence)
+                    GraphContent(viewModel.graphSamples, viewModel.graphCount, graphVersion, confidence)
                 }
             }
         }
@@ -388,23 +388,30 @@ fun LightingWarningBanner(msg: String, modifier: Modifier = Modifier) {
     }
 }
 
+// signalData[0 until count] is rewritten in place; version changes with it (0 = empty)
 @Composable
-fun GraphContent(signalData: List<Float>, confidence: Float) {
+fun GraphContent(signalData: FloatArray, count: Int, version: Int, confidence: Float) {
     Canvas(modifier = Modifier.fillMaxSize().clip(RoundedCornerShape(8.dp))) {
-        if (signalData.isEmpty()) return@Canvas
+        if (version == 0 || count == 0) return@Canvas
 
         val width = size.width
         val height = size.height
-        val minValue = signalData.minOrNull() ?: 0f
-        val maxValue = signalData.maxOrNull() ?: 1f
-        val range = (maxValue - minValue).coerceAtLeast(1f)
+        var minValue = signalData[0]
+        var maxValue = signalData[0]
+        for (index in 1 until count) {
+            minValue = minOf(minValue, signalData[index])
+            maxValue = maxOf(maxValue, signalData[index])
+        }
+        // The pulse trace is unit-free and often spans ~0.02, so scale to its
+        // own range; the floor only keeps a flat trace from dividing by zero
+        val range = (maxValue - minValue).coerceAtLeast(1e-6f)
 
         val path = Path()
-        val stepX = width / (signalData.size - 1).coerceAtLeast(1)
+        val stepX = width / (count - 1).coerceAtLeast(1)
 
-        signalData.forEachIndexed { index, value ->
+        for (index in 0 until count) {
             val x = index * stepX
-            val normalizedValue = (value - minValue) / range
+            val normalizedValue = (signalData[index] - minValue) / range
             val y = height - (normalizedValue * height * 0.8f) - height * 0.1f
             if (index == 0) path.moveTo(x, y) else path.lineTo(x, y)
         }
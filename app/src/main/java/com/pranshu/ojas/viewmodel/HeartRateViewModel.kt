@@ -18,6 +18,10 @@ import kotlinx.coroutines.Job
 import kotlinx.coroutines.delay
 import kotlinx.coroutines.flow.*
 import kotlinx.coroutines.launch
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.nio.FloatBuffer
+import java.util.concurrent.TimeUnit
 
 @RequiresApi(Build.VERSION_CODES.VANILLA_ICE_CREAM)
 class HeartRateViewModel(application: Application) : AndroidViewModel(application) {
@@ -27,8 +31,19 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
     var faceTracker: FaceTracker? = null
     private var pulseML: PulseML? = null
 
-    // Native processor (C++)
-    private val signalProcessor = NativeSignalProcessor(bufferSize = 300, samplingRate = 30f)
+    // Native processor (C++). Per-frame samples go through the shared ring and
+    // a native worker analyses them once a second; computeHeartRate() below
+    // just reads its latest result.
+    private val signalProcessor = NativeSignalProcessor(bufferSize = WINDOW_SIZE, samplingRate = 30f).apply {
+        // The pulse trace is high-passed at ~0.7 Hz, below which breathing lies
+        setRespirationEnabled(false)
+        enableSharedInput()
+        startAnalysisWorker(intervalMs = 1000)
+    }
+
+    // Respiration from the raw ROI green, which keeps the 0.1 - 0.5 Hz band;
+    // fed on the collecting thread and read once a second
+    private val respirationProcessor = NativeSignalProcessor(bufferSize = WINDOW_SIZE, samplingRate = 30f)
 
     // --- Ghost Features (Now Active!) ---
     private val hrvAnalyzer = HRVAnalyzer()
@@ -39,12 +54,38 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
     private val _heartRate = MutableStateFlow(0f)
     val heartRate: StateFlow<Float> = _heartRate.asStateFlow()
 
-    private val _signalBuffer = MutableStateFlow<List<Float>>(emptyList())
-    val signalBuffer: StateFlow<List<Float>> = _signalBuffer.asStateFlow()
+    // Graph trace: the newest samples, rewritten in place. graphVersion changes
+    // whenever graphSamples does; 0 means there is nothing to draw.
+    val graphSamples = FloatArray(GRAPH_POINTS)
+    var graphCount = 0
+        private set
+    private val _graphVersion = MutableStateFlow(0)
+    val graphVersion: StateFlow<Int> = _graphVersion.asStateFlow()
+
+    // Native window snapshot, refilled in place by readWaveform()
+    private val waveform: FloatBuffer = ByteBuffer.allocateDirect(WINDOW_SIZE * 4)
+        .order(ByteOrder.nativeOrder())
+        .asFloatBuffer()
+    private var waveformSequence = -1
+    private var analysisWindow = FloatArray(0)
+
+    // Raw ROI green (0 - 255) of the frames behind the pulse trace, oldest
+    // at greenHead once full. SignalQualityIndicator's SNR and noise terms and
+    // the PulseML model were tuned on this scale, and the model cannot be
+    // retrained here, so they keep reading green while the unit-free CHROM/POS
+    // trace drives the heart rate, HRV and graph.
+    private val greenRing = FloatArray(WINDOW_SIZE)
+    private var greenHead = 0
+    private var greenCount = 0
+    private var greenWindow = FloatArray(0)
 
     private val _status = MutableStateFlow(MeasurementStatus.INITIALIZING)
     val status: StateFlow<MeasurementStatus> = _status.asStateFlow()
 
+    // Breaths per minute; 0 until ~30 s of face tracking are in
+    private val _respirationRate = MutableStateFlow(0f)
+    val respirationRate: StateFlow<Float> = _respirationRate.asStateFlow()
+
     private val _confidence = MutableStateFlow(0f)
     val confidence: StateFlow<Float> = _confidence.asStateFlow()
 
@@ -59,6 +100,7 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
     private var processingJob: Job? = null
     private var hrComputationJob: Job? = null
     private var currentHrEstimate = 0f
+    private var lastSampleNs = 0L
     private val alpha = 0.15f // Smoothing factor
 
     private val _faceDetected = MutableStateFlow(false)
@@ -92,15 +134,27 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
             tracker.landmarks.collect { _landmarks.value = it }
         }
 
-        // 1. Collect Green Signal from Face
+        // 1. Collect the chrominance pulse signal (POS by default) from the face
         processingJob = viewModelScope.launch {
-            tracker.faceDetected.combine(tracker.greenSignal) { detected, green ->
-                Pair(detected, green)
-            }.collect { (detected, green) ->
+            tracker.faceDetected.combine(tracker.pulseSignal) { detected, pulse ->
+                Pair(detected, pulse)
+            }.collect { (detected, pulse) ->
                 if (detected) {
-                    signalProcessor.addSample(green)
-                    val sampleCount = signalProcessor.getCurrentSampleCount()
-                    updateStatus(sampleCount)
+                    // combine() repeats the last sample when detection changes
+                    if (pulse.timestampNs == lastSampleNs) return@collect
+                    lastSampleNs = pulse.timestampNs
+                    addGreen(pulse.green)
+                    respirationProcessor.addSample(
+                        pulse.green, TimeUnit.NANOSECONDS.toMillis(pulse.timestampNs)
+                    )
+                    if (!pulse.warmingUp) {
+                        // Capture time, not collection time, so the resampler sees the
+                        // camera's real frame spacing
+                        signalProcessor.addSample(
+                            pulse.value, TimeUnit.NANOSECONDS.toMillis(pulse.timestampNs)
+                        )
+                    }
+                    updateStatus(signalProcessor.getCurrentSampleCount())
                 } else {
                     _status.value = MeasurementStatus.NO_FACE
                     _signalQualityMsg.value = "" // Clear warnings
@@ -112,18 +166,33 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
         hrComputationJob = viewModelScope.launch {
             while (true) {
                 delay(1000) // Run every second
-                if (signalProcessor.getCurrentSampleCount() >= 150) {
+                _respirationRate.value = respirationProcessor.computeRespirationRate()
+                if (signalProcessor.getCurrentSampleCount() >= MIN_ANALYSIS_SAMPLES) {
                     analyzeSignal()
                 }
             }
         }
     }
 
+    private fun addGreen(green: Float) {
+        greenRing[(greenHead + greenCount) % WINDOW_SIZE] = green
+        if (greenCount < WINDOW_SIZE) greenCount++ else greenHead = (greenHead + 1) % WINDOW_SIZE
+    }
+
+    // Oldest-first copy of the green ring, reused once the ring is full
+    private fun readGreen(): FloatArray {
+        if (greenWindow.size != greenCount) greenWindow = FloatArray(greenCount)
+        for (i in 0 until greenCount) greenWindow[i] = greenRing[(greenHead + i) % WINDOW_SIZE]
+        return greenWindow
+    }
+
+    // sampleCount is pulse samples, so a face stays ACQUIRING through the
+    // pulse stage's warm-up as well
     private fun updateStatus(sampleCount: Int) {
         if (_status.value != MeasurementStatus.COMPLETED) {
             _status.value = when {
-                sampleCount < 90 -> MeasurementStatus.ACQUIRING
-                sampleCount < 300 -> MeasurementStatus.TRACKING
+                sampleCount < TRACKING_SAMPLES -> MeasurementStatus.ACQUIRING
+                sampleCount < WINDOW_SIZE -> MeasurementStatus.TRACKING
                 else -> MeasurementStatus.MEASURING
             }
         }
@@ -133,10 +202,21 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
     private fun analyzeSignal() {
         viewModelScope.launch {
             try {
-                val bufferFloatArray = signalProcessor.getSignalBuffer()
+                // Skip the pass if no samples arrived since the last one
+                val sequence = signalProcessor.readWaveform(waveform, waveformSequence)
+                if (sequence == waveformSequence) return@launch
+                waveformSequence = sequence
+
+                // Reused once the window is full, so steady state allocates nothing
+                val count = waveform.limit()
+                if (analysisWindow.size != count) analysisWindow = FloatArray(count)
+                waveform.get(analysisWindow)
+                val bufferFloatArray = analysisWindow
+
+                val green = readGreen()
 
                 // --- A. Quality Check (Ghost Feature #1) ---
-                val quality = qualityIndicator.computeOverallQuality(bufferFloatArray, 30f)
+                val quality = qualityIndicator.computeOverallQuality(green, 30f)
 
                 // Update UI warning if quality is bad
                 if (quality == SignalQuality.POOR || quality == SignalQuality.VERY_POOR) {
@@ -156,7 +236,7 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
                 // Filter valid range (45-200 BPM)
                 if (rawHR > 45 && rawHR < 200) {
                     // Refine with AI
-                    var finalHR = pulseML?.refineHeartRate(bufferFloatArray, rawHR) ?: rawHR
+                    var finalHR = pulseML?.refineHeartRate(green, rawHR) ?: rawHR
 
                     // Fallback if AI returns 45 (clamped) but raw was good
                     if (finalHR == 45f && rawHR > 50) finalHR = rawHR
@@ -169,7 +249,9 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
                     }
 
                     _heartRate.value = currentHrEstimate
-                    _signalBuffer.value = bufferFloatArray.takeLast(150).toList()
+                    graphCount = minOf(GRAPH_POINTS, count)
+                    System.arraycopy(bufferFloatArray, count - graphCount, graphSamples, 0, graphCount)
+                    _graphVersion.value += 1
 
                     // --- C. Stress/HRV Analysis (Ghost Feature #2) ---
                     // Only analyze stress if we have a full 10s buffer (300 samples)
@@ -195,10 +277,15 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
 
     fun reset() {
         signalProcessor.reset()
+        respirationProcessor.reset()
+        _respirationRate.value = 0f
         currentHrEstimate = 0f
         _heartRate.value = 0f
         _stressLevel.value = "Analyzing..."
-        _signalBuffer.value = emptyList()
+        graphCount = 0
+        _graphVersion.value = 0
+        greenHead = 0
+        greenCount = 0
         _status.value = MeasurementStatus.INITIALIZING
     }
 
@@ -206,11 +293,21 @@ class HeartRateViewModel(application: Application) : AndroidViewModel(applicatio
         super.onCleared()
         faceTracker?.release()
         signalProcessor.release()
+        respirationProcessor.release()
         pulseML?.release()
     }
 
     companion object {
         private const val TAG = "HeartRateViewModel"
+        private const val WINDOW_SIZE = 300   // ~10 seconds at 30fps
+
+        // Pulse samples before tracking (3 s) and before the first analysis
+        // (5 s). They count from the pulse stage's first output, which POS
+        // holds back for one window (~1.6 s) after the face is found, so with
+        // POS the first reading comes ~6.6 s and MEASURING ~11.6 s after lock.
+        private const val TRACKING_SAMPLES = 90
+        private const val MIN_ANALYSIS_SAMPLES = 150
+        private const val GRAPH_POINTS = 150
     }
 }
 
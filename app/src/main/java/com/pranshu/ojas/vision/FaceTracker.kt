@@ -1,21 +1,29 @@
 package com.pranshu.ojas.vision
 
-import com.google.mediapipe.framework.image.BitmapExtractor
 import android.content.Context
 import android.graphics.Bitmap
 import android.graphics.RectF
 import android.util.Log
+import androidx.camera.core.ImageProxy
 import com.google.mediapipe.framework.image.BitmapImageBuilder
 import com.google.mediapipe.tasks.core.BaseOptions
+import com.google.mediapipe.tasks.vision.core.ImageProcessingOptions
 import com.google.mediapipe.tasks.vision.core.RunningMode
 import com.google.mediapipe.tasks.vision.facelandmarker.FaceLandmarker
 import com.google.mediapipe.tasks.vision.facelandmarker.FaceLandmarkerResult
+import com.pranshu.ojas.core.NativeChromProcessor
+import com.pranshu.ojas.core.NativePosProcessor
+import com.pranshu.ojas.core.NativeRoiExtractor
+import com.pranshu.ojas.core.NativeRoiFusion
 import kotlinx.coroutines.flow.MutableStateFlow
 import kotlinx.coroutines.flow.StateFlow
+import java.util.concurrent.atomic.AtomicBoolean
 
 /**
  * Face tracking using MediaPipe Face Landmarker
- * Extracts ROI (forehead/cheeks) and computes average green channel intensity
+ * Extracts ROI (forehead/cheeks) and computes their mean colour, published as
+ * the raw green mean and as a CHROM or POS pulse sample (one trace per ROI,
+ * fused by in-band SNR)
  */
 class FaceTracker(context: Context) {
 
@@ -26,6 +34,11 @@ class FaceTracker(context: Context) {
     private val _greenSignal = MutableStateFlow(0f)
     val greenSignal: StateFlow<Float> = _greenSignal
 
+    // Chrominance pulse signal from pulseMethod, robust to lighting changes and motion,
+    // stamped with the sensor time of the frame it came from
+    private val _pulseSignal = MutableStateFlow(PulseSample(0f, 0f, 0L))
+    val pulseSignal: StateFlow<PulseSample> = _pulseSignal
+
     private val _landmarks = MutableStateFlow<List<Pair<Float, Float>>>(emptyList())
     val landmarks: StateFlow<List<Pair<Float, Float>>> = _landmarks
 
@@ -36,6 +49,34 @@ class FaceTracker(context: Context) {
     private val leftCheekIndices = listOf(205, 207, 187, 123, 116, 100, 36)
     private val rightCheekIndices = listOf(425, 427, 411, 352, 345, 329, 266)
 
+    // ROI polygons flattened for the native extractor
+    private val roiPolygons = listOf(foreheadIndices, leftCheekIndices, rightCheekIndices)
+    private val polygonIndices = roiPolygons.flatten().toIntArray()
+    private val polygonStarts = roiPolygons.runningFold(0) { start, roi -> start + roi.size }.toIntArray()
+    private val roiStats = FloatArray(roiPolygons.size * NativeRoiExtractor.VALUES_PER_ROI)
+
+    // Pulse stage behind pulseSignal. POS lags by one window (~1.6 s) but
+    // tolerates motion and specular changes better than CHROM.
+    @Volatile
+    var pulseMethod = PulseMethod.POS
+
+    // Pulse stages with one lane per ROI, fused by SNR so a shadowed cheek
+    // does not drag the forehead down; only touched by processSignalFrame()
+    private val chrom = NativeChromProcessor(channelCount = roiPolygons.size, samplingRate = 30f)
+    private val pos = NativePosProcessor(channelCount = roiPolygons.size, samplingRate = 30f)
+    private val fusion = NativeRoiFusion(channelCount = roiPolygons.size, samplingRate = 30f)
+    private val roiColour = FloatArray(3)
+    private val roiColours = FloatArray(3 * roiPolygons.size)
+    private val pulse = FloatArray(roiPolygons.size)
+    private var primedMethod: PulseMethod? = null
+
+    // Latest landmarks as normalized upright (x, y) pairs; empty while no face is tracked
+    @Volatile
+    private var landmarkCoords = FloatArray(0)
+
+    // Set while a frame is with the landmarker, so frames are only converted when it can take one
+    private val detectionInFlight = AtomicBoolean(false)
+
     init {
         initializeFaceLandmarker(context)
     }
@@ -53,12 +94,13 @@ class FaceTracker(context: Context) {
                 .setMinFaceDetectionConfidence(0.5f)
                 .setMinFacePresenceConfidence(0.5f)
                 .setMinTrackingConfidence(0.5f)
-                .setResultListener { result, input ->
-                    val bitmap = BitmapExtractor.extract(input) // <--- FIX
-                    handleFaceLandmarkerResult(result, bitmap)
+                .setResultListener { result, _ ->
+                    handleFaceLandmarkerResult(result)
+                    detectionInFlight.set(false)
                 }
                 .setErrorListener { error ->
                     Log.e(TAG, "FaceLandmarker error: ${error.message}")
+                    detectionInFlight.set(false)
                 }
                 .build()
 
@@ -70,19 +112,75 @@ class FaceTracker(context: Context) {
     }
 
     /**
-     * Process a camera frame to detect face and extract green signal
+     * True when the landmarker can take a new frame; callers should only
+     * build a Bitmap for processFrame() then
+     */
+    fun isReadyForFrame(): Boolean = faceLandmarker != null && !detectionInFlight.get()
+
+    /**
+     * Submit a sensor-oriented camera frame for face landmark detection.
+     * The landmarker applies rotationDegrees itself, so landmarks come back
+     * in upright coordinates without rotating the bitmap here.
      */
-    fun processFrame(bitmap: Bitmap, timestampMs: Long) {
+    fun processFrame(bitmap: Bitmap, rotationDegrees: Int, timestampMs: Long) {
+        val landmarker = faceLandmarker ?: return
+        if (!detectionInFlight.compareAndSet(false, true)) return
         try {
             val mpImage = BitmapImageBuilder(bitmap).build()
-            faceLandmarker?.detectAsync(mpImage, timestampMs)
+            val options = ImageProcessingOptions.builder()
+                .setRotationDegrees(rotationDegrees)
+                .build()
+            landmarker.detectAsync(mpImage, options, timestampMs)
         } catch (e: Exception) {
+            detectionInFlight.set(false)
             Log.e(TAG, "Error processing frame", e)
         }
     }
 
-    private fun handleFaceLandmarkerResult(result: FaceLandmarkerResult, bitmap: Bitmap?) {
+    /**
+     * Update the green and pulse signals from a YUV_420_888 frame using the
+     * latest landmarks. ROI colour is read straight from the planes, so no
+     * frame is converted or rotated for the signal path.
+     */
+    fun processSignalFrame(image: ImageProxy) {
+        val coords = landmarkCoords
+        val method = pulseMethod
+        if (coords.isEmpty() || !extractRoiColour(image, coords)) {
+            // Restart the pulse stage's window when tracking resumes
+            resetPulseStage()
+            if (coords.isNotEmpty()) {
+                _greenSignal.value = 0f
+                _pulseSignal.value = PulseSample(0f, 0f, image.imageInfo.timestamp)
+            }
+            return
+        }
+        _greenSignal.value = roiColour[1]
+        if (primedMethod != method) resetPulseStage()
+        primedMethod = method
+        val ready = when (method) {
+            PulseMethod.CHROM -> chrom.process(roiColours, pulse)
+            PulseMethod.POS -> pos.process(roiColours, pulse)
+        }
+        _pulseSignal.value = if (ready) {
+            PulseSample(fusion.addFrame(pulse), roiColour[1], image.imageInfo.timestamp)
+        } else {
+            // Stage still filling its first window (POS: latencyFrames frames)
+            PulseSample(0f, roiColour[1], image.imageInfo.timestamp, warmingUp = true)
+        }
+    }
+
+    private fun resetPulseStage() {
+        when (primedMethod ?: return) {
+            PulseMethod.CHROM -> chrom.reset()
+            PulseMethod.POS -> pos.reset()
+        }
+        fusion.reset()
+        primedMethod = null
+    }
+
+    private fun handleFaceLandmarkerResult(result: FaceLandmarkerResult) {
         if (result.faceLandmarks().isEmpty()) {
+            landmarkCoords = FloatArray(0)
             _faceDetected.value = false
             return
         }
@@ -98,110 +196,83 @@ class FaceTracker(context: Context) {
         }
         _landmarks.value = landmarkPoints
 
-        // Extract ROI and compute green signal
-        if (bitmap != null) {
-            val greenValue = extractGreenSignal(bitmap, faceLandmarks)
-            _greenSignal.value = greenValue
+        val coords = FloatArray(faceLandmarks.size * 2)
+        faceLandmarks.forEachIndexed { i, landmark ->
+            coords[2 * i] = landmark.x()
+            coords[2 * i + 1] = landmark.y()
         }
+        landmarkCoords = coords
     }
 
     /**
-     * Extract average green channel intensity from face ROI
+     * Pixel-weighted mean R, G, B of the face ROIs into roiColour and each
+     * ROI's own mean into roiColours (skin pixels of the forehead and cheek
+     * polygons, classified and rasterized natively on the YUV planes, so
+     * eyebrows, hair and glasses frames inside a hull are skipped). An ROI
+     * without skin pixels keeps its last colour.
+     * False if no ROI pixel was covered.
      */
-    private fun extractGreenSignal(
-        bitmap: Bitmap,
-        landmarks: List<com.google.mediapipe.tasks.components.containers.NormalizedLandmark>
-    ): Float {
-        val width = bitmap.width
-        val height = bitmap.height
-
-        // Collect ROI pixels from forehead and cheeks
-        val roiPixels = mutableListOf<Int>()
-
-        // Extract forehead region
-        foreheadIndices.forEach { index ->
-            if (index < landmarks.size) {
-                val landmark = landmarks[index]
-                val x = (landmark.x() * width).toInt().coerceIn(0, width - 1)
-                val y = (landmark.y() * height).toInt().coerceIn(0, height - 1)
-
-                // Sample 3x3 region around landmark
-                for (dy in -1..1) {
-                    for (dx in -1..1) {
-                        val px = (x + dx).coerceIn(0, width - 1)
-                        val py = (y + dy).coerceIn(0, height - 1)
-                        try {
-                            roiPixels.add(bitmap.getPixel(px, py))
-                        } catch (e: Exception) {
-                            // Skip invalid pixels
-                        }
-                    }
-                }
-            }
-        }
+    private fun extractRoiColour(image: ImageProxy, coords: FloatArray): Boolean {
+        val rois = NativeRoiExtractor.computeRoiStats(
+            image, coords, polygonIndices, polygonStarts, roiStats, skinOnly = true
+        )
 
-        // Extract left cheek region
-        leftCheekIndices.forEach { index ->
-            if (index < landmarks.size) {
-                val landmark = landmarks[index]
-                val x = (landmark.x() * width).toInt().coerceIn(0, width - 1)
-                val y = (landmark.y() * height).toInt().coerceIn(0, height - 1)
-
-                for (dy in -1..1) {
-                    for (dx in -1..1) {
-                        val px = (x + dx).coerceIn(0, width - 1)
-                        val py = (y + dy).coerceIn(0, height - 1)
-                        try {
-                            roiPixels.add(bitmap.getPixel(px, py))
-                        } catch (e: Exception) {
-                            // Skip
-                        }
-                    }
-                }
+        // Pixel-weighted colour mean over all ROIs
+        roiColour.fill(0f)
+        var pixelCount = 0f
+        for (i in 0 until rois) {
+            val base = i * NativeRoiExtractor.VALUES_PER_ROI
+            val pixels = roiStats[base + NativeRoiExtractor.PIXEL_COUNT]
+            for (c in 0 until 3) {
+                roiColour[c] += roiStats[base + NativeRoiExtractor.MEAN_R + c] * pixels
             }
+            pixelCount += pixels
         }
+        if (pixelCount <= 0f) return false
+
+        for (c in 0 until 3) roiColour[c] /= pixelCount
 
-        // Extract right cheek region
-        rightCheekIndices.forEach { index ->
-            if (index < landmarks.size) {
-                val landmark = landmarks[index]
-                val x = (landmark.x() * width).toInt().coerceIn(0, width - 1)
-                val y = (landmark.y() * height).toInt().coerceIn(0, height - 1)
-
-                for (dy in -1..1) {
-                    for (dx in -1..1) {
-                        val px = (x + dx).coerceIn(0, width - 1)
-                        val py = (y + dy).coerceIn(0, height - 1)
-                        try {
-                            roiPixels.add(bitmap.getPixel(px, py))
-                        } catch (e: Exception) {
-                            // Skip
-                        }
-                    }
+        // Per-ROI lanes; one that was never covered since the last reset
+        // starts from the pooled colour
+        for (i in roiPolygons.indices) {
+            val base = i * NativeRoiExtractor.VALUES_PER_ROI
+            val covered = i < rois && roiStats[base + NativeRoiExtractor.PIXEL_COUNT] > 0f
+            for (c in 0 until 3) {
+                roiColours[3 * i + c] = when {
+                    covered -> roiStats[base + NativeRoiExtractor.MEAN_R + c]
+                    primedMethod == null -> roiColour[c]
+                    else -> roiColours[3 * i + c]
                 }
             }
         }
-
-        // Compute average green channel value
-        if (roiPixels.isEmpty()) {
-            return 0f
-        }
-
-        var greenSum = 0f
-        roiPixels.forEach { pixel ->
-            val green = (pixel shr 8) and 0xFF
-            greenSum += green.toFloat()
-        }
-
-        return greenSum / roiPixels.size
+        return true
     }
 
     fun release() {
         faceLandmarker?.close()
         faceLandmarker = null
+        chrom.release()
+        pos.release()
+        fusion.release()
     }
 
     companion object {
         private const val TAG = "FaceTracker"
     }
-}
\ No newline at end of file
+}
+
+enum class PulseMethod {
+    CHROM, POS
+}
+
+/**
+ * One pulse value, the ROI mean green (0 - 255) of the same camera frame and
+ * its sensor timestamp (ImageInfo.timestamp: monotonic nanoseconds, taken at
+ * capture). While warmingUp the pulse stage has no output yet and value is 0.
+ */
+data class PulseSample(
+    val value: Float,
+    val green: Float,
+    val timestampNs: Long,
+    val warmingUp: Boolean = false
+)